@@ -9,12 +9,32 @@ namespace Rune {
 }
 
 namespace Attack {
+    // Attack map entries overwritten by one update, enough to undo it without copying the maps
+    struct Undo {
+        // Moved, captured and castling entries (5) plus every slider on the board (at most 26)
+        static constexpr int MAX_ENTRIES = 32;
+
+        Bitboard previous[MAX_ENTRIES];     // Entry value before the update
+        uint8_t index[MAX_ENTRIES];         // color * 64 + square
+        int count;
+    };
+
     class Worker {
+    private:
+        // Keep attackCount and attackMapFull in step with one attack map entry change
+        void countAttacks(int color, Bitboard removed, Bitboard added);
+        void rebuildCounts(int color);
+
     public:
         Bitboard attackMap[2][64];     
         Bitboard attackMapFull[2];     
         Bitboard attackMapIncludes;
 
+        // Number of pieces of each color attacking a square, stored as bit planes:
+        // bit i of a square's count lives in attackCount[color][i], attackMapFull is their union
+        static constexpr int COUNT_PLANES = 5;
+        Bitboard attackCount[2][COUNT_PLANES];
+
         void generatePawns(Rune::Game& game, PieceColor color);
         void generateKnights(Rune::Game& game, PieceColor color);
         void generateKing(Rune::Game& game, PieceColor color);
@@ -24,15 +44,19 @@ namespace Attack {
         void printTable(Rune::Game& game, int side);
 
         void generateAll(Rune::Game& game);
-        void update(Rune::Game& game, Move move);
+        void update(Rune::Game& game, Move move, Undo& undo);
+        void restore(const Undo& undo);
+        void setAttacks(int color, int square, Bitboard attacks, Undo& undo);
 
         bool isSquareAttackedBy(int square, int color);
-        
-        Bitboard getNewAttacksForMove(Rune::Game& game, Move move);
-        Bitboard getAttackersForSquare(Rune::Game& game, int color, int square);
-        Bitboard getAttackersForZone(Rune::Game& game, Bitboard zone, int color, int type);
 
-        PrecomputedTables::AttackTable preComputed;
+        // Pieces attacking a square with sliders seen through the given occupancy,
+        // pieces removed from the occupancy are still returned so callers mask them out
+        Bitboard attackersTo(Rune::Game& game, int square, Bitboard occupancy);
+        Bitboard attackersTo(Rune::Game& game, int square, Bitboard occupancy, int color);
+
+        // Shared compile-time tables, kept as a member name so call sites read the same
+        static constexpr const PrecomputedTables::AttackTable& preComputed = PrecomputedTables::attackTable;
     };
 
 } // namespace Attack
\ No newline at end of file
@@ -61,8 +61,6 @@ namespace Board {
     std::string moveToString(Move move);
     Move parseMove(Rune::Game& game, const std::string& moveStr);
 
-    inline void setSquare(Rune::Game& game, int square, Piece piece);
-
     // ----------------------------
     // Move legality & castling
     // ----------------------------
@@ -78,7 +76,6 @@ namespace Board {
     bool isSameLine(int from, int to, int offset);
     int findKing(Rune::Game& game, int color);
     bool isKingInCheck(Rune::Game& game, int color);
-    bool moveGivesCheck(Rune::Game& game, Move move);
 
     Bitboard getSlidingPiecesBitboard(Rune::Game& game, int color);
 
@@ -44,25 +44,68 @@ namespace Movegen {
         void clear() { count = 0; }
     };
     
+    // What a generate<> instantiation produces
+    enum GenType {
+        CAPTURES,       // Captures, including capture promotions & en passant
+        QUIETS,         // Non-captures, including quiet promotions & castling
+        EVASIONS,       // Moves that may resolve a check (side to move is in check)
+        QUIET_CHECKS,   // Non-captures that give check, promotions & castling excluded
+        ALL             // CAPTURES + QUIETS
+    };
+
+    // Everything needed to tell whether a move checks the enemy king, computed once per node
+    struct CheckInfo {
+        int kingSquare = -1;            // Enemy king, -1 when there is none
+        Bitboard checkSquares[7] = {};  // Squares from which each piece type attacks the enemy king
+        Bitboard discovered = 0ULL;     // Own pieces whose departure from the line uncovers a check
+    };
+
     class Worker {
+    private:
+        // Compile-time specialized generators, targets limits the destination squares
+        template <int Color, GenType Type>
+        void generatePawnMoves(Rune::Game& game, MoveList& moves, Bitboard pawns, Bitboard targets);
+
+        template <int Color, int Piece, GenType Type>
+        void generatePieceMoves(Rune::Game& game, MoveList& moves, Bitboard pieces, Bitboard targets);
+
+        template <int Color, GenType Type>
+        void generateAll(Rune::Game& game, MoveList& moves, Bitboard targets, Bitboard kingTargets);
+
+        template <int Color>
+        void generateEvasions(Rune::Game& game, MoveList& moves, int kingSquare, Bitboard checkers);
+
+        template <int Color>
+        void generateQuietChecks(Rune::Game& game, MoveList& moves);
+
     public:
+        // Generate one kind of pseudo-legal moves for the side to move (appends to moves)
+        template <GenType Type>
+        void generate(Rune::Game& game, MoveList& moves);
+
         // Internal helpers
         void addPromotionMoves(MoveList& moves, int from, int to, int isCapture);
         bool canCastleThroughBitboard(int square, Bitboard occupancy, Bitboard enemyAttacks);
 
-        // Piece move generators
-        void getPawnMoves(Rune::Game& game, MoveList& moves, bool onlyCaptures);
-        void getKnightMoves(Rune::Game& game, MoveList& moves, bool onlyCaptures);
-        void getKingMoves(Rune::Game& game, MoveList& moves, bool onlyCaptures);
-        void getSlidingMoves(Rune::Game& game, MoveList& moves, PieceType type, bool onlyCaptures);
-
         // Castling
         bool canCastleThrough(Rune::Game& game, int square, Bitboard occupancy, Bitboard enemyAttacks);
         void getCastleMoves(Rune::Game& game, MoveList& moves);
 
+        // Legality
+        Bitboard getBlockers(Rune::Game& game, int square, int sliderColor, int blockerColor);
+        bool isLegal(Rune::Game& game, Move move, int kingSquare, Bitboard pinned, Bitboard checkTargets);
+
+        // Checks given by the side to move
+        void getCheckInfo(Rune::Game& game, CheckInfo& info);
+        bool givesCheck(Rune::Game& game, Move move, const CheckInfo& info);
+
         // Full move generation
         void getPseudoMoves(Rune::Game& game, MoveList& moves, bool onlyCaptures);
+        void getEvasionMoves(Rune::Game& game, MoveList& moves, int kingSquare, Bitboard checkers, bool onlyCaptures);
         void getLegalMoves(Rune::Game& game, MoveList& moves, bool onlyCaptures);
+
+        // Legal moves that give check, built from captures and quiet checks instead of the full move list
+        void getLegalChecks(Rune::Game& game, MoveList& moves);
     };
 
 } // namespace Movegen
\ No newline at end of file
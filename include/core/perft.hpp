@@ -17,4 +17,22 @@ namespace Perft {
     // Performs perft from the root position
     void root(Rune::Game& game, int depth);
 
+    // Checks incremental attack map updates against full rebuilds over random playouts
+    void attackTest(Rune::Game& game, int playouts);
+
+    // Checks givesCheck and the check generators against make/unmake over random playouts
+    void checkTest(Rune::Game& game, int playouts);
+
+    // Runs go depth and go mate on mated, stalemated and short root move lists, with one and several PV slots
+    void searchTest(Rune::Game& game);
+
+    // Perft speed over the test positions at their deepest depth, reports nodes per second
+    void bench(Rune::Game& game);
+
+    // Time of a make/unmake pair over random playouts from the test positions, move generation excluded
+    void makeBench(Rune::Game& game, int repeats);
+
+    // Times the magic and PEXT slider lookups against each other, rebuilding the tables for each
+    void magicBench(int lookups);
+
 } // namespace Perft
\ No newline at end of file
@@ -1,8 +1,9 @@
 #pragma once
 
 // --- Standard Library ---
-#include <memory>   // std::unique_ptr
+#include <vector>
 #include <string>
+#include <type_traits>
 
 // --- Tables & Utilities ---
 #include <tables/constants.hpp>
@@ -20,14 +21,111 @@
 
 namespace Rune {
 
+    // --- Compact position: pieces, side to move, rights, counters & key ---
+    // Trivially copyable, so it can be cloned with a plain copy (copy-make, threads, perft splitting)
+    struct Position {
+        // Board & pieces
+        Bitboard board[2][7] = {};      // Pieces by side/type
+        Bitboard occupancy[3] = {};     // Side occupancy
+        Piece boardGhost[64] = {};      // Full piece array
+
+        // Hash
+        ZobristHash zobristKey = 0ULL;
+
+        // Turn & move info
+        int turn = WHITE;
+        int enpassantSquare = -1;
+        int ply = 0;
+        int fiftyMoveCounter = 0;
+        CastlingRights castlingRights = CASTLING_ALL;
+        bool hasCastled[2] = {false, false};
+
+        inline void setSquare(int square, Piece piece);
+
+        // XOR-mask piece updates for make/unmake, the caller knows what stands on each square
+        inline void movePiece(Piece piece, int from, int to);
+        inline void addPiece(Piece piece, int square);
+        inline void removePiece(Piece piece, int square);
+
+        // Apply a move (pieces, rights, en passant, turn, counters & key), returns the captured piece
+        Piece makeMove(Move move);
+        void makeNullMove();
+
+        // Put the pieces back for a move, the caller restores turn, rights, counters & key
+        void unmakeMove(Move move, Piece captured);
+    };
+
+    static_assert(std::is_trivially_copyable<Position>::value, "Position must stay trivially copyable");
+    static_assert(sizeof(Position) <= 256, "Position must stay within 256 bytes");
+
+    inline void Position::setSquare(int square, Piece piece)
+    {
+        const Bitboard bit = 1ULL << square;
+
+        Piece old_piece = boardGhost[square];
+        int old_type = Helpers::get_type(old_piece);
+
+        // Remove old piece
+        if (old_type != EMPTY) {
+            int old_color = Helpers::get_color(old_piece);
+            board[old_color][old_type] &= ~bit;
+            occupancy[old_color] &= ~bit;
+        }
+
+        // Place new piece
+        int new_type = Helpers::get_type(piece);
+        if (new_type != EMPTY) {
+            int new_color = Helpers::get_color(piece);
+            board[new_color][new_type] |= bit;
+            occupancy[new_color] |= bit;
+        }
+
+        boardGhost[square] = piece;
+
+        // Combined occupancy
+        occupancy[BOTH] = occupancy[WHITE] | occupancy[BLACK];
+    }
+
+    inline void Position::movePiece(Piece piece, int from, int to)
+    {
+        const Bitboard mask = (1ULL << from) | (1ULL << to);
+        const int color = Helpers::get_color(piece);
+
+        board[color][Helpers::get_type(piece)] ^= mask;
+        occupancy[color] ^= mask;
+        occupancy[BOTH]  ^= mask;
+
+        boardGhost[from] = EMPTY;
+        boardGhost[to]   = piece;
+    }
+
+    inline void Position::addPiece(Piece piece, int square)
+    {
+        const Bitboard bit = 1ULL << square;
+        const int color = Helpers::get_color(piece);
+
+        board[color][Helpers::get_type(piece)] ^= bit;
+        occupancy[color] ^= bit;
+        occupancy[BOTH]  ^= bit;
+
+        boardGhost[square] = piece;
+    }
+
+    inline void Position::removePiece(Piece piece, int square)
+    {
+        const Bitboard bit = 1ULL << square;
+        const int color = Helpers::get_color(piece);
+
+        board[color][Helpers::get_type(piece)] ^= bit;
+        occupancy[color] ^= bit;
+        occupancy[BOTH]  ^= bit;
+
+        boardGhost[square] = EMPTY;
+    }
+
     // --- Snapshot of game state for history / undo ---
     class State {
     public:
-        // Board & pieces
-        Bitboard board[3][7];      // Pieces per type/side
-        Bitboard occupancy[3];     // Side occupancy
-        Piece boardGhost[64];      // Full piece array
-
         // Turn & move info
         int turn;
         int enpassantSquare;
@@ -35,9 +133,8 @@ namespace Rune {
         Piece capturedPiece;
         Move move;
 
-        // Attack maps
-        Bitboard attackMapFull[2];
-        Bitboard attackMap[2][64];
+        // Attack map entries changed by the move
+        Attack::Undo attackUndo;
 
         // Misc
         ZobristHash zobristKey;
@@ -45,21 +142,11 @@ namespace Rune {
     };
 
     // --- Main game class ---
-    class Game {
+    class Game : public Position {
     public:
-        static constexpr size_t HISTORY_SIZE = 32768;
-
-        // Board & pieces
-        Bitboard board[3][7];       // Pieces by type/side
-        Bitboard occupancy[3];      // Side occupancy
-        Piece boardGhost[64];
-
-        // Turn & move info
-        int turn;
-        int enpassantSquare;
-        CastlingRights castlingRights;
-        int ply;
-        bool hasCastled[2];
+        // Undo records reserved up front: a long game plus the deepest search line, grown on demand past that
+        static constexpr size_t HISTORY_GAME_PLIES   = 512;
+        static constexpr size_t HISTORY_SEARCH_PLIES = 256;
 
         // Move generation
         Movegen::MoveList movelist;
@@ -80,16 +167,26 @@ namespace Rune {
         // History
         int historyCount;
         bool isFirstLoad;
-        std::unique_ptr<State[]> history;
+        std::vector<State> history;
 
         // Misc
         bool outOfOpeningBook;
-        ZobristHash zobristKey;
         std::string pvLine;
 
         // Constructor / Destructor
         Game();
         ~Game();
+
+        // Next free undo record, doubling the history when it is full
+        inline State& pushState();
     };
 
+    inline State& Game::pushState()
+    {
+        if (historyCount == static_cast<int>(history.size()))
+            history.resize(history.size() * 2);
+
+        return history[historyCount++];
+    }
+
 } // namespace Rune
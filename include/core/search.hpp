@@ -18,6 +18,14 @@ namespace Search {
         int score;
     };
 
+    // Root move that survives between iterations of iterative deepening
+    struct RootMove {
+        Move move;
+        int score;
+        long long nodes;            // Size of this move's subtree in the last iteration
+        std::vector<Move> pv;       // Line found for this move in the last iteration
+    };
+
     enum MoveRequestType {
         QUIESCENSE,
         NEGAMAX
@@ -35,6 +43,10 @@ namespace Search {
             
             const int NULL_MOVE_PRUNE_REDUCTION = 2;
 
+            const int INTERNAL_ITERATIVE_REDUCTION_DEPTH = 4;
+
+            const int CURRMOVE_INFO_DELAY_MS = 1000;
+
             const int HISTORY_MAX       = 160000;
             const int HISTORY_SCALE_FAC = 8;
 
@@ -46,22 +58,34 @@ namespace Search {
             TimePoint lastDepthFinishedAt;
 
             int thinkTime = 0;
+            long long nodeLimit = 0;
 
             bool searchCancelled = false;
 
             std::array<std::array<std::array<int, 64>, 64>, 2> betaCutoffHistory {};
 
-            const int mvvLvaScores[5][5] = {
-                {900, 700, 680, 500, 100},
-                {2700, 2400, 2380, 2200, 1800},
-                {2900, 2600, 2580, 2400, 2000},
-                {4900, 4600, 4580, 4400, 4000},
-                {8900, 8600, 8580, 8400, 8000}
+            // [victim][attacker], pawn through queen victims and pawn through king attackers
+            const int mvvLvaScores[5][6] = {
+                {900, 700, 680, 500, 100, 50},
+                {2700, 2400, 2380, 2200, 1800, 1750},
+                {2900, 2600, 2580, 2400, 2000, 1950},
+                {4900, 4600, 4580, 4400, 4000, 3950},
+                {8900, 8600, 8580, 8400, 8000, 7950}
             };
 
+            // Exchange values, a king is never given up in an exchange
+            const int seeValues[7] = {0, 100, 320, 335, 500, 900, 20000};
+
             Move ttMove = 0;
             Move pvMove = 0;
 
+            long long nodes = 0;
+            long long qnodes = 0;
+
+            int selDepth = 0;
+
+            std::vector<RootMove> rootMoves;
+
             void checkTimer();
 
             double getTimer();
@@ -69,26 +93,32 @@ namespace Search {
 
             int getMvvLvaScore(Rune::Game& game, Move move);
 
-            bool predictCheck(Rune::Game& game, Move move);
-            bool predictRecapture(Rune::Game& game, Move move);
-
             bool isNullMovePruneSafe(Rune::Game& game, Movegen::MoveList& movelist);
 
+            void initRootMoves(Rune::Game& game, const std::vector<Move>& searchMoves);
+            void sortRootMoves(Move bestMove);
+
             void addBetaCutoff(Move move, int depth, int turn);
             void updateBetaCutoffHistory();
 
-            int evaluateStaticExchange(Rune::Game& game, int to);
-            int getLeastValuablePiece(Rune::Game& game, Bitboard options);
+            int staticExchange(Rune::Game& game, Move move);
+            int getLeastValuableAttacker(Rune::Game& game, Bitboard attackers, int color, int& type);
         
         public:
             const int maximumSearchTime = 1000000;
 
+            // True when the exchange started by move wins at least threshold (early-exit SEE)
+            bool seeGE(Rune::Game& game, Move move, int threshold);
+
             void orderMoves(Rune::Game& game, Movegen::MoveList& movelist);
             void requestMoves(Rune::Game& game, Movegen::MoveList& movelist, MoveRequestType requestType);
 
             int quiescense(Rune::Game& game, int depth, int alpha, int beta, int ply, std::vector<Move>& pv);
             int negamax(Rune::Game& game, int depth, int alpha, int beta, int ply, std::vector<Move>& pv);
 
-            Move searchPosition(Rune::Game& game, int initialDepth, int thinkTimeMs);
+            int mateSearch(Rune::Game& game, int depth, int alpha, int beta, int ply, std::vector<Move>& pv);
+
+            Move searchPosition(Rune::Game& game, int initialDepth, int thinkTimeMs, long long maxNodes = 0, const std::vector<Move>& searchMoves = {});
+            Move searchMate(Rune::Game& game, int mateMoves, int thinkTimeMs, long long maxNodes = 0);
     };
 } // namespace Search
\ No newline at end of file
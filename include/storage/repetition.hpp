@@ -15,8 +15,6 @@ namespace Repetition {
             size_t count = 0;                             // Number of stored hashes
 
         public:
-            int fiftyMoveCounter = 0;
-            
             // Push a new position hash onto the stack
             void push(ZobristHash hash);
 
@@ -26,11 +24,14 @@ namespace Repetition {
             // Clear the repetition table
             void clear();
 
-            // Check if the current hash occurred three times
-            bool checkThreefold(ZobristHash hash);
+            // Check if the last pushed hash repeats within the last `window` plies (the fifty-move counter).
+            // An earlier occurrence inside the search tree (under `ply` plies back) is enough, before it takes two
+            bool isRepetition(int window, int ply) const;
 
-            bool checkThreefoldRecent(size_t recentMoves);
+            // Check if the side to move has a reversible move back to a position within the last `window` plies,
+            // through the cuckoo tables. Only positions inside the search tree (under `ply` plies back) count
+            bool hasUpcomingRepetition(Bitboard occupancy, int window, int ply) const;
 
-            bool checkFiftyMoveRule();
+            bool checkFiftyMoveRule(int fiftyMoveCounter);
     };
 } // namespace Repetition
\ No newline at end of file
@@ -11,12 +11,14 @@ namespace Transposition {
 
     struct TTEntry {
         ZobristHash key;    // Position key
-        int depth;          // Depth at which entry was stored
-        int eval;           // Evaluation
-        int flag;           // TT_EXACT / TT_ALPHA / TT_BETA
+        int32_t eval;       // Evaluation
         Move best_move;     // Best move found
+        uint8_t depth;      // Depth at which entry was stored
+        uint8_t flag;       // TT_EXACT / TT_ALPHA / TT_BETA
     };
 
+    static_assert(sizeof(TTEntry) == 16, "TTEntry should stay at 16 bytes");
+
     class Table {
         private:
             const static size_t TT_SIZE = (1 << 8);
@@ -26,6 +28,9 @@ namespace Transposition {
             bool probe(ZobristHash key, int depth, int alpha, int beta, int ply, int& out_score, Move& bestMove);
             void store(ZobristHash key, int depth, int eval, int flag, Move best_move, int ply);
             void clear();
+
+            // Permille of sampled entries in use, as reported by UCI hashfull
+            int hashfull();
     };
 
 } // namespace Transposition
\ No newline at end of file
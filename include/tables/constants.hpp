@@ -6,7 +6,7 @@ typedef uint64_t Bitboard;
 typedef uint64_t AttackTable;
 typedef uint64_t ZobristHash;
 
-typedef uint32_t Move;
+typedef uint16_t Move;
 
 typedef uint8_t CastlingRights;
 typedef uint8_t Piece;
@@ -14,16 +14,21 @@ typedef uint8_t Piece;
 typedef int PieceType;
 typedef int PieceColor;
 
-#define FROM_MASK     0x0000003F      // bits 0-5
-#define TO_MASK       0x00000FC0      // bits 6-11
-#define PROMO_MASK    0x00007000      // bits 12-14 (3 bits)
+// Move layout: from (6 bits) | to (6 bits) | kind (4 bits)
+#define FROM_MASK     0x003F          // bits 0-5
+#define TO_MASK       0x0FC0          // bits 6-11
+#define KIND_MASK     0xF000          // bits 12-15
 
-#define CAPTURE_MASK  0x00008000      // bit 15
-#define PROMO_FLAG    0x00010000      // bit 16
-#define ENPASSANT     0x00020000      // bit 17
-#define CHECK         0x00040000      // bit 18
-#define DOUBLE_PUSH   0x00080000      // bit 19
-#define CASTLE        0x00100000      // bit 20
+#define CAPTURE_MASK  0x4000          // kind bit 2, set for every capture
+#define PROMO_FLAG    0x8000          // kind bit 3, set for every promotion
+
+// Move kinds, the low two bits of a promotion kind hold the promoted piece - KNIGHT
+#define MOVE_QUIET          0x0
+#define MOVE_DOUBLE_PUSH    0x1
+#define MOVE_CASTLE         0x2
+#define MOVE_CAPTURE        0x4
+#define MOVE_ENPASSANT      0x5
+#define MOVE_PROMOTION      0x8
 
 #define WHITE_KINGSIDE  (1 << 0)
 #define WHITE_QUEENSIDE (1 << 1)
@@ -40,6 +45,9 @@ typedef int PieceColor;
 #define RANK_2 0x000000000000FF00ULL
 #define RANK_7 0x00FF000000000000ULL
 
+#define RANK_3 0x0000000000FF0000ULL
+#define RANK_6 0x0000FF0000000000ULL
+
 #define RANK_8 0xFF00000000000000ULL
 #define RANK_1 0x00000000000000FFULL
 
@@ -9,16 +9,18 @@ namespace Helpers {
     // Bitboard / move helpers
     inline int get_from(Move m)       { return m & FROM_MASK; }
     inline int get_to(Move m)         { return (m & TO_MASK) >> 6; }
-    inline int get_promo(Move m)      { return (m & PROMO_MASK) >> 12; }
+    inline int get_kind(Move m)       { return (m & KIND_MASK) >> 12; }
     inline int get_color(Piece p)     { return (p & PIECE_COLOR_MASK) >> 3; }
     inline int get_type(Piece p)      { return (p & PIECE_TYPE_MASK); }
 
     inline bool is_capture(Move m)    { return (m & CAPTURE_MASK) != 0; }
     inline bool is_promo(Move m)      { return (m & PROMO_FLAG) != 0; }
-    inline bool is_enpassant(Move m)  { return (m & ENPASSANT) != 0; }
-    inline bool is_check(Move m)      { return (m & CHECK) != 0; }
-    inline bool is_double_push(Move m){ return (m & DOUBLE_PUSH) != 0; }
-    inline bool is_castle(Move m)     { return (m & CASTLE) != 0; }
+    inline bool is_enpassant(Move m)  { return get_kind(m) == MOVE_ENPASSANT; }
+    inline bool is_double_push(Move m){ return get_kind(m) == MOVE_DOUBLE_PUSH; }
+    inline bool is_castle(Move m)     { return get_kind(m) == MOVE_CASTLE; }
+
+    // Promoted piece type, EMPTY for non-promotions
+    inline int get_promo(Move m)      { return is_promo(m) ? (get_kind(m) & 0x3) + KNIGHT : EMPTY; }
 
     // Min / Max templates
     template<typename T>
@@ -50,17 +52,22 @@ namespace Helpers {
         return val;
     }
 
-    inline Move move(int from, int to, int promo, int capture, int promo_flag, int ep, int check, int dp, int castle)
+    constexpr Move make_move(int from, int to, int kind)
+    {
+        return (Move) ((from & 0x3F) | ((to & 0x3F) << 6) | (kind << 12));
+    }
+
+    inline Move move(int from, int to, int promo, int capture, int promo_flag, int ep, int dp, int castle)
     {
-        return (((from) & 0x3F) | \
-                (((to) & 0x3F) << 6) | \
-                (((promo) & 0x7) << 12) | \
-                ((capture) ? CAPTURE_MASK : 0) | \
-                ((promo_flag) ? PROMO_FLAG : 0) | \
-                ((ep) ? ENPASSANT : 0) | \
-                ((check) ? CHECK : 0) | \
-                ((dp) ? DOUBLE_PUSH : 0) | \
-                ((castle) ? CASTLE : 0));
+        int kind = MOVE_QUIET;
+
+        if (promo_flag)   kind = MOVE_PROMOTION | (((promo & PIECE_TYPE_MASK) - KNIGHT) & 0x3) | (capture ? MOVE_CAPTURE : 0);
+        else if (ep)      kind = MOVE_ENPASSANT;
+        else if (capture) kind = MOVE_CAPTURE;
+        else if (dp)      kind = MOVE_DOUBLE_PUSH;
+        else if (castle)  kind = MOVE_CASTLE;
+
+        return make_move(from, to, kind);
     }
 
     inline int findLargestOfThree(int a, int b, int c)
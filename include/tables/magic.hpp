@@ -2,26 +2,87 @@
 
 #include <cstdint>
 #include <tables/constants.hpp>
-#include <tables/magic_bitboards.hpp>
+
+// The PEXT backend only exists in builds with BMI2 enabled, init() then checks the CPU can run it fast
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
 
 namespace Magic {
 
+    constexpr int BISHOP_TABLE_SIZE = 5248;     // Sum of 2^bits over the bishop masks
+    constexpr int ROOK_TABLE_SIZE   = 102400;   // Sum of 2^bits over the rook masks
+
+    // Per-square lookup data, attacks points at this square's slice of the packed tables
+    struct SquareMagic {
+        Bitboard  mask;          // Relevant blockers, board edges excluded
+        Bitboard  magic;         // Only searched for when the tables are in magic order
+        Bitboard* attacks;       // Indexed by (blockers * magic) >> shift, or by PEXT(blockers)
+        unsigned  shift;
+    };
+
+    extern SquareMagic bishopMagics[64];
+    extern SquareMagic rookMagics[64];
+
+    // Chosen once by init(), true when the PEXT backend is compiled in and fast on this CPU
+    extern bool usePext;
+
+    // Pick the lookup backend and fill the packed tables for it (runs once, thread safe)
+    void init();
+
+    // Refill the packed tables in PEXT or magic order and switch usePext to match,
+    // there is a single table per piece so only one backend is valid at a time
+    void build(bool pext);
+
+    // CPUID check for BMI2, excluding AMD before Zen 3 where PEXT is microcoded
+    bool hasFastPext();
+
+    // ----------------------------
+    // Multiply-shift lookups, valid while usePext is false
+    // ----------------------------
+    inline Bitboard getBishopAttacksMagic(int square, Bitboard occupancy) {
+        const SquareMagic& m = bishopMagics[square];
+        return m.attacks[((occupancy & m.mask) * m.magic) >> m.shift];
+    }
+
+    inline Bitboard getRookAttacksMagic(int square, Bitboard occupancy) {
+        const SquareMagic& m = rookMagics[square];
+        return m.attacks[((occupancy & m.mask) * m.magic) >> m.shift];
+    }
+
+#if defined(__BMI2__)
+    // ----------------------------
+    // PEXT lookups, valid while usePext is true
+    // ----------------------------
+    inline Bitboard getBishopAttacksPext(int square, Bitboard occupancy) {
+        const SquareMagic& m = bishopMagics[square];
+        return m.attacks[_pext_u64(occupancy, m.mask)];
+    }
+
+    inline Bitboard getRookAttacksPext(int square, Bitboard occupancy) {
+        const SquareMagic& m = rookMagics[square];
+        return m.attacks[_pext_u64(occupancy, m.mask)];
+    }
+#endif
+
     // ----------------------------
     // Bishop attacks
     // ----------------------------
     inline Bitboard getBishopAttacks(int square, Bitboard occupancy) {
-        Bitboard blockers = occupancy & bishop_masks[square];
-        std::size_t index = static_cast<std::size_t>((blockers * bishop_magics[square]) >> bishop_shifts[square]);
-        return bishop_attack_tables[square][index];
+#if defined(__BMI2__)
+        if (usePext) return getBishopAttacksPext(square, occupancy);
+#endif
+        return getBishopAttacksMagic(square, occupancy);
     }
 
     // ----------------------------
     // Rook attacks
     // ----------------------------
     inline Bitboard getRookAttacks(int square, Bitboard occupancy) {
-        Bitboard blockers = occupancy & rook_masks[square];
-        std::size_t index = static_cast<std::size_t>((blockers * rook_magics[square]) >> rook_shifts[square]);
-        return rook_attack_tables[square][index];
+#if defined(__BMI2__)
+        if (usePext) return getRookAttacksPext(square, occupancy);
+#endif
+        return getRookAttacksMagic(square, occupancy);
     }
 
     // ----------------------------
@@ -31,4 +92,4 @@ namespace Magic {
         return getBishopAttacks(square, occupancy) | getRookAttacks(square, occupancy);
     }
 
-} // namespace Magic
\ No newline at end of file
+} // namespace Magic
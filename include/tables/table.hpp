@@ -4,25 +4,43 @@
 
 namespace PrecomputedTables {
 
+    // Built at compile time and shared by every Game, nothing is computed at startup
     class AttackTable {
     public:
-        Bitboard pieces[7][64];      // Precomputed attacks for pieces
-        Bitboard pawns[2][64];       // Precomputed pawn attacks
-        uint8_t  castling[64][64];
-
-        // Precompute all tables (call once at initialization)
-        void preComputeKing();
-        void preComputeKnight();
-        void preComputeSliding(PieceType type);
-        void preComputePawn(int color);
-        void preComputeCastling();
-
-        void preComputeAll();
-
-        Bitboard getPawnAttacks(int color, int square);
-        Bitboard getKnightAttacks(int square);
-        Bitboard getSlidingAttacks(int square, PieceType type);
-        Bitboard getKingAttacks(int square);
+        Bitboard pieces[7][64] = {};      // Empty-board attacks for knight through king
+        Bitboard pawns[2][64] = {};       // Pawn captures by color
+        Bitboard between[64][64] = {};    // Squares strictly between two aligned squares
+        Bitboard line[64][64] = {};       // Full line through two aligned squares
+
+        Bitboard getPawnAttacks(int color, int square) const    { return pawns[color][square]; }
+        Bitboard getKnightAttacks(int square) const             { return pieces[KNIGHT][square]; }
+        Bitboard getSlidingAttacks(int square, PieceType type) const { return pieces[type][square]; }
+        Bitboard getKingAttacks(int square) const               { return pieces[KING][square]; }
+    };
+
+    extern const AttackTable attackTable;
+
+    // Rook squares of a castling move, indexed by the king's destination (g or c file)
+    struct CastlingRooks {
+        int8_t from[64] = {};
+        int8_t to[64] = {};
     };
 
-} // namespace PrecomputedTables
\ No newline at end of file
+    constexpr CastlingRooks buildCastlingRooks()
+    {
+        CastlingRooks rooks{};
+
+        for (int base = 0; base <= 56; base += 56)
+        {
+            rooks.from[base + 6] = base + 7;    // Kingside: h-file rook to f
+            rooks.to[base + 6]   = base + 5;
+            rooks.from[base + 2] = base + 0;    // Queenside: a-file rook to d
+            rooks.to[base + 2]   = base + 3;
+        }
+
+        return rooks;
+    }
+
+    inline constexpr CastlingRooks castlingRooks = buildCastlingRooks();
+
+} // namespace PrecomputedTables
@@ -6,6 +6,7 @@
 
 namespace Rune {
     class Game; // forward declaration
+    struct Position;
 }
 
 namespace Zobrist {
@@ -15,17 +16,53 @@ namespace Zobrist {
     constexpr int NUM_CASTLING    = 16;
     constexpr int NUM_ENPASSANT   = 8;
 
-    // Compute the Zobrist hash of the current position
-    ZobristHash compute(Rune::Game& game);
+    // Random keys, generated at compile time and shared by every Game
+    struct Keys {
+        ZobristHash pieces[NUM_PIECE_TYPES][NUM_SQUARES] = {};
+        ZobristHash castling[NUM_CASTLING] = {};
+        ZobristHash enpassant[NUM_ENPASSANT] = {};
+        ZobristHash turn = 0;
+    };
 
-    // Update hash after a board change
-    void updateBoard(Rune::Game& game);
+    extern const Keys keys;
 
-    // Update hash after a move
-    void updateMove(Rune::Game& game, Move move, Rune::State& oldState);
+    // Cuckoo tables of every reversible piece move (knight to king, both colors, empty board),
+    // keyed by the hash change the move makes including the side to move.
+    // A key difference between two positions found here means one move connects them
+    constexpr int CUCKOO_SIZE = 8192;
 
-    // Initialize Zobrist random keys
-    void init();
+    struct Cuckoo {
+        ZobristHash keys[CUCKOO_SIZE] = {};
+        Move moves[CUCKOO_SIZE] = {};
+        int count = 0;
+    };
+
+    extern const Cuckoo cuckoo;
+
+    // The two slots a key may occupy
+    constexpr int cuckooH1(ZobristHash key) { return key & (CUCKOO_SIZE - 1); }
+    constexpr int cuckooH2(ZobristHash key) { return (key >> 16) & (CUCKOO_SIZE - 1); }
+
+    // piece_to_index[color][piece_type]
+    // piece_type is 1..6 (Pawn, Knight, Bishop, Rook, Queen, King), EMPTY is never hashed
+    inline constexpr int piece_to_index[2][7] = {
+        {0, 0, 1, 2, 3, 4, 5},       // white
+        {6, 6, 7, 8, 9, 10, 11}      // black
+    };
+
+    // Keys for incremental updates
+    inline ZobristHash pieceKey(Piece piece, int square) {
+        return keys.pieces[piece_to_index[Helpers::get_color(piece)][Helpers::get_type(piece)]][square];
+    }
+    inline ZobristHash castlingKey(CastlingRights rights) { return keys.castling[rights]; }
+    inline ZobristHash enpassantKey(int file)             { return keys.enpassant[file]; }
+    inline ZobristHash turnKey()                          { return keys.turn; }
+
+    // Compute the Zobrist hash of a position
+    ZobristHash compute(const Rune::Position& position);
+
+    // Recompute the stored hash from scratch (after loading a position)
+    void updateBoard(Rune::Position& position);
 
     // Convert a hash to a string representation (for debugging)
     std::string hashToString(ZobristHash hash);
@@ -36,11 +36,13 @@ namespace Config {
         bool doQuiescense = true;
         bool doTranspositions = true;
         bool doBetaCutoffHistory = true;
+        bool doSeePruning = true;
         bool doInfo = true;
 
         int initialDepth = 9;
         int maximumDepth = 32;
         int maximumQuiescenseDepth = 16;
+        int multiPV = 1;
 
         bool doOpeningBook = false;
     };
@@ -17,6 +17,7 @@ namespace UCI {
     constexpr const char *__UCI_AUTHOR__ = "Samuel 't Hart";
 
     void debug(const char* file, const char* format, ...);
-    void printSearchResult(int depth, int score, int timeMs, bool isMate, std::string pvCurrent);
+    void printSearchResult(int depth, int selDepth, int multiPV, int score, bool isMate, long long nodes, int timeMs, int hashfull, std::string pvCurrent);
+    void printCurrentMove(int depth, Move move, int moveNumber);
     void uciLoop(Rune::Game& game);
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 
 #include <stdbool.h>
 #include <stdlib.h>
+#include <cassert>
 #include <string>
 #include <iostream>
 
@@ -106,10 +107,8 @@ namespace Attack {
         generateSliding(game, side, ROOK);
         generateSliding(game, side, QUEEN);
 
-        // Build full attack union for side — iterate all squares (safe & simple)
-        for (int s = 0; s < 64; ++s) {
-            this->attackMapFull[side] |= this->attackMap[side][s];
-        }
+        // Counts and the full attack union for side
+        rebuildCounts(side);
     }
 
     void Worker::printTable(Rune::Game& game, int side)
@@ -197,11 +196,75 @@ namespace Attack {
             }
 
             this->attackMap[color][square] = attacks;
-            this->attackMapFull[color] |= attacks;
+        }
+
+        rebuildCounts(WHITE);
+        rebuildCounts(BLACK);
+    }
+
+    void Worker::rebuildCounts(int color)
+    {
+        std::fill(&this->attackCount[color][0], &this->attackCount[color][0] + COUNT_PLANES, 0ULL);
+
+        for (int square = 0; square < 64; square++)
+            countAttacks(color, 0ULL, this->attackMap[color][square]);
+    }
+
+    void Worker::countAttacks(int color, Bitboard removed, Bitboard added)
+    {
+        Bitboard* planes = this->attackCount[color];
+
+        // Bit-parallel decrement and increment, one ripple per plane for all squares at once
+        for (int i = 0; i < COUNT_PLANES && removed; i++)
+        {
+            Bitboard borrow = ~planes[i] & removed;
+            planes[i] ^= removed;
+            removed = borrow;
+        }
+
+        for (int i = 0; i < COUNT_PLANES && added; i++)
+        {
+            Bitboard carry = planes[i] & added;
+            planes[i] ^= added;
+            added = carry;
+        }
+
+        this->attackMapFull[color] = planes[0] | planes[1] | planes[2] | planes[3] | planes[4];
+    }
+
+    void Worker::setAttacks(int color, int square, Bitboard attacks, Undo& undo)
+    {
+        Bitboard& entry = this->attackMap[color][square];
+
+        if (entry == attacks) return;
+
+        assert(undo.count < Undo::MAX_ENTRIES);
+
+        undo.previous[undo.count] = entry;
+        undo.index[undo.count] = (uint8_t) (color * 64 + square);
+        undo.count++;
+
+        countAttacks(color, entry & ~attacks, attacks & ~entry);
+
+        entry = attacks;
+    }
+
+    void Worker::restore(const Undo& undo)
+    {
+        // Newest first, so an entry written twice ends at its oldest value
+        for (int i = undo.count - 1; i >= 0; i--)
+        {
+            const int color = undo.index[i] >> 6;
+
+            Bitboard& entry = this->attackMap[color][undo.index[i] & 63];
+
+            countAttacks(color, entry & ~undo.previous[i], undo.previous[i] & ~entry);
+
+            entry = undo.previous[i];
         }
     }
 
-    void Worker::update(Rune::Game& game, Move move)
+    void Worker::update(Rune::Game& game, Move move, Undo& undo)
     {
         const int from = Helpers::get_from(move);
         const int to   = Helpers::get_to(move);
@@ -211,103 +274,71 @@ namespace Attack {
         const PieceColor color = Helpers::get_color(movedPiece);
         const PieceColor opponent = PieceColor(color ^ 1);
 
-        // Determine the moved piece type (handle promotion)
-        PieceType movedType = Helpers::get_type(movedPiece);
-        if (Helpers::is_promo(move)) {
-            movedType = Helpers::get_promo(move);
-        }
+        undo.count = 0;
 
-        // --- Clear old attacks for moving piece ---
-        this->attackMap[color][from] = 0ULL;
+        // Squares whose occupancy changed, sliders looking through them need new attacks
+        Bitboard changed = (1ULL << from) | (1ULL << to);
 
-        // --- Clear opponent's attacks from 'to' square ---
-        this->attackMap[opponent][to] = 0ULL;
+        // --- Moving piece leaves 'from' ---
+        setAttacks(color, from, 0ULL, undo);
 
-        // --- Handle en passant ---
-        int captureSq = to;
+        // --- Captured piece (on 'to', or behind it for en passant) ---
         if (Helpers::is_enpassant(move)) {
-            captureSq = (color == WHITE) ? (to - 8) : (to + 8);
+            int captureSq = (color == WHITE) ? (to - 8) : (to + 8);
+
+            setAttacks(opponent, captureSq, 0ULL, undo);
+            changed |= 1ULL << captureSq;
+        } else {
+            setAttacks(opponent, to, 0ULL, undo);
         }
 
-        // --- Clear attacks of captured piece ---
-        Piece capturedPiece = game.boardGhost[captureSq];
-        if (Helpers::get_type(capturedPiece) != EMPTY) {
-            PieceColor capColor = Helpers::get_color(capturedPiece);
-            this->attackMap[capColor][captureSq] = 0ULL;
-        } else if (Helpers::is_enpassant(move)) {
-            this->attackMap[opponent][captureSq] = 0ULL;
+        // --- Castling, the rook moves as well ---
+        if (Helpers::is_castle(move)) {
+            int rookFrom = PrecomputedTables::castlingRooks.from[to];
+            int rookTo   = PrecomputedTables::castlingRooks.to[to];
+
+            setAttacks(color, rookFrom, 0ULL, undo);
+            setAttacks(color, rookTo, Magic::getRookAttacks(rookTo, occ), undo);
+            changed |= (1ULL << rookFrom) | (1ULL << rookTo);
         }
 
-        // --- Add new attacks for moved piece ---
+        // --- Add new attacks for moved piece (already promoted on the board) ---
         Bitboard newAtt = 0ULL;
-        switch (movedType) {
+        switch (Helpers::get_type(movedPiece)) {
             case BISHOP: newAtt = Magic::getBishopAttacks(to, occ); break;
             case ROOK:   newAtt = Magic::getRookAttacks(to, occ); break;
-            case QUEEN:  newAtt = Magic::getBishopAttacks(to, occ) | Magic::getRookAttacks(to, occ); break;
+            case QUEEN:  newAtt = Magic::getQueenAttacks(to, occ); break;
             case PAWN:   newAtt = this->preComputed.pawns[color][to]; break;
             case KNIGHT: newAtt = this->preComputed.pieces[KNIGHT][to]; break;
             case KING:   newAtt = this->preComputed.pieces[KING][to]; break;
             default: break;
         }
-        this->attackMap[color][to] = newAtt;
-
-        // --- Update sliders affected by from/to moves ---
-        Bitboard sliderOccupancy =
-            game.board[WHITE][BISHOP] | game.board[WHITE][ROOK] | game.board[WHITE][QUEEN] |
-            game.board[BLACK][BISHOP] | game.board[BLACK][ROOK] | game.board[BLACK][QUEEN];
+        setAttacks(color, to, newAtt, undo);
 
-        Bitboard affected =
-            sliderOccupancy & (
-                Magic::getBishopAttacks(from, occ) | Magic::getBishopAttacks(to, occ) |
-                Magic::getRookAttacks(from, occ)   | Magic::getRookAttacks(to, occ)
-            );
-
-        while (affected) {
-            int sq = __builtin_ctzll(affected);
-            affected &= affected - 1;
-
-            Piece p = game.boardGhost[sq];
-            PieceColor c = Helpers::get_color(p);
-            PieceType pt = Helpers::get_type(p);
+        // --- Update sliders affected by the changed squares ---
+        Bitboard diagonal =
+            game.board[WHITE][BISHOP] | game.board[WHITE][QUEEN] |
+            game.board[BLACK][BISHOP] | game.board[BLACK][QUEEN];
 
-            if (pt == BISHOP)       newAtt = Magic::getBishopAttacks(sq, occ);
-            else if (pt == ROOK)    newAtt = Magic::getRookAttacks(sq, occ);
-            else if (pt == QUEEN)   newAtt = Magic::getBishopAttacks(sq, occ) | Magic::getRookAttacks(sq, occ);
-            else continue;
+        Bitboard orthogonal =
+            game.board[WHITE][ROOK] | game.board[WHITE][QUEEN] |
+            game.board[BLACK][ROOK] | game.board[BLACK][QUEEN];
 
-            this->attackMap[c][sq] = newAtt;
-        }
+        Bitboard affected = 0ULL;
 
-        // --- Update pawns, knights, king for moving color ---
-        Bitboard pcs;
+        while (changed) {
+            int sq = Helpers::pop_lsb(changed);
 
-        pcs = game.board[color][PAWN];
-        while (pcs) {
-            int sq = __builtin_ctzll(pcs);
-            pcs &= pcs - 1;
-            this->attackMap[color][sq] = this->preComputed.pawns[color][sq];
+            affected |= (Magic::getBishopAttacks(sq, occ) & diagonal) |
+                        (Magic::getRookAttacks(sq, occ)   & orthogonal);
         }
 
-        pcs = game.board[color][KNIGHT];
-        while (pcs) {
-            int sq = __builtin_ctzll(pcs);
-            pcs &= pcs - 1;
-            this->attackMap[color][sq] = this->preComputed.pieces[KNIGHT][sq];
-        }
+        while (affected) {
+            int sq = Helpers::pop_lsb(affected);
 
-        pcs = game.board[color][KING];
-        if (pcs) {
-            int sq = __builtin_ctzll(pcs);
-            this->attackMap[color][sq] = this->preComputed.pieces[KING][sq];
-        }
+            Piece p = game.boardGhost[sq];
 
-        // --- Recompute full attack map for both colors ---
-        for (int c = 0; c < 2; c++) {
-            Bitboard unionAtt = 0ULL;
-            for (int s = 0; s < 64; s++) {
-                unionAtt |= this->attackMap[c][s];
-            }
-            this->attackMapFull[c] = unionAtt;
+            setAttacks(Helpers::get_color(p), sq, attackGetSlider(Helpers::get_type(p), sq, occ), undo);
         }
     }
 
@@ -316,59 +347,28 @@ namespace Attack {
         return (this->attackMapFull[color] & (1ULL << square)) != 0;
     }
 
-    Bitboard Worker::getNewAttacksForMove(Rune::Game& game, Move move)
-    {
-        int from = Helpers::get_from(move);
-        int to   = Helpers::get_to(move);
-
-        Piece fPiece = game.boardGhost[from];
-
-        int type  = Helpers::get_type(fPiece);
-        int color = Helpers::get_color(fPiece);
-
-        switch (type)
-        {
-            case PAWN: return this->preComputed.getPawnAttacks(color, to); break;
-            case KNIGHT: return this->preComputed.getKnightAttacks(to); break;
-            case BISHOP: return Magic::getBishopAttacks(to, game.occupancy[BOTH]); break;
-            case ROOK: return Magic::getRookAttacks(to, game.occupancy[BOTH]); break;
-            case QUEEN: return Magic::getQueenAttacks(to, game.occupancy[BOTH]); break;
-            case KING: return this->preComputed.getKingAttacks(to); break;
-            default: return 0ULL; break;
-        }
-
-        return 0ULL;
-    }
-
-    Bitboard Worker::getAttackersForSquare(Rune::Game& game, int color, int target)
+    Bitboard Worker::attackersTo(Rune::Game& game, int square, Bitboard occupancy)
     {
-        Bitboard attackers = 0;
-        Bitboard squareMask = (1ULL << target);
-        Bitboard occupancy = game.occupancy[color];
-
-        while (occupancy)
-        {
-            int sq = Helpers::pop_lsb(occupancy);
-
-            if (attackMap[color][sq] & squareMask)
-                attackers |= (1ULL << sq);
-        }
-        
-        return attackers;
+        Bitboard diagonal   = game.board[WHITE][BISHOP] | game.board[WHITE][QUEEN] | game.board[BLACK][BISHOP] | game.board[BLACK][QUEEN];
+        Bitboard orthogonal = game.board[WHITE][ROOK]   | game.board[WHITE][QUEEN] | game.board[BLACK][ROOK]   | game.board[BLACK][QUEEN];
+
+        return (this->preComputed.pawns[BLACK][square]   & game.board[WHITE][PAWN])
+             | (this->preComputed.pawns[WHITE][square]   & game.board[BLACK][PAWN])
+             | (this->preComputed.pieces[KNIGHT][square] & (game.board[WHITE][KNIGHT] | game.board[BLACK][KNIGHT]))
+             | (this->preComputed.pieces[KING][square]   & (game.board[WHITE][KING]   | game.board[BLACK][KING]))
+             | (Magic::getBishopAttacks(square, occupancy) & diagonal)
+             | (Magic::getRookAttacks(square, occupancy)   & orthogonal);
     }
 
-    Bitboard Worker::getAttackersForZone(Rune::Game& game, Bitboard zone, int color, int type)
+    Bitboard Worker::attackersTo(Rune::Game& game, int square, Bitboard occupancy, int color)
     {
-        Bitboard attackers = 0;
-        Bitboard pieces = game.board[color][type]; // all pieces of this type
-
-        while (pieces) {
-            int sq = Helpers::pop_lsb(pieces);
-
-            if (attackMap[color][sq] & zone)  // piece attacks zone
-                attackers |= (1ULL << sq);
-        }
-
-        return attackers; // squares of attacking pieces
+        Bitboard diagonal   = game.board[color][BISHOP] | game.board[color][QUEEN];
+        Bitboard orthogonal = game.board[color][ROOK]   | game.board[color][QUEEN];
+
+        return (this->preComputed.pawns[!color][square]  & game.board[color][PAWN])
+             | (this->preComputed.pieces[KNIGHT][square] & game.board[color][KNIGHT])
+             | (this->preComputed.pieces[KING][square]   & game.board[color][KING])
+             | (Magic::getBishopAttacks(square, occupancy) & diagonal)
+             | (Magic::getRookAttacks(square, occupancy)   & orthogonal);
     }
 }
\ No newline at end of file
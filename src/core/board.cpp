@@ -10,6 +10,7 @@
 #include <string>
 #include <cstring>
 #include <cctype>
+#include <cassert>
 #include <algorithm>
 
 namespace Rune {
@@ -77,8 +78,11 @@ namespace Board {
 
     void loadFen(Rune::Game& game, std::string fenString)
     {
-        // Clear board
-        std::fill(&game.board[0][0], &game.board[0][0] + 2*7*64, 0);
+        // Reset the position: pieces, side to move, rights, counters & key
+        static_cast<Rune::Position&>(game) = Rune::Position();
+
+        // Moves played before belong to the old position
+        game.historyCount = 0;
 
         const char* ptr = fenString.c_str();
         int square = 56; // A8
@@ -93,7 +97,7 @@ namespace Board {
                 int empty = c - '0';
                 for (int i = 0; i < empty; i++)
                 {
-                    setSquare(game, square, Helpers::make_piece(EMPTY, EMPTY));
+                    game.setSquare(square, Helpers::make_piece(EMPTY, EMPTY));
                     square++;
                 }
             }
@@ -117,7 +121,7 @@ namespace Board {
                     default:  type = EMPTY;  break;
                 }
 
-                setSquare(game, square, Helpers::make_piece(type, color));
+                game.setSquare(square, Helpers::make_piece(type, color));
                 square++;
             }
 
@@ -163,6 +167,10 @@ namespace Board {
         game.attackWorker.generateTable(game, BLACK);
 
         Zobrist::updateBoard(game);
+
+        // Repetitions are counted from the loaded position
+        game.repetitionTable.clear();
+        game.repetitionTable.push(game.zobristKey);
         
         game.isFirstLoad = 0;
     }
@@ -185,46 +193,7 @@ namespace Board {
         Bitboard occupancy = game.occupancy[BOTH];
 
         // Bitboard of checking pieces
-        Bitboard checkers_bb = 0ULL;
-
-        for (int type = PAWN; type <= KING; type++)
-        {
-            Bitboard pieces = game.board[them][type];
-
-            while (pieces)
-            {
-                int square = __builtin_ctzll(pieces);
-                pieces &= pieces - 1;
-
-                Bitboard attacks = 0ULL;
-
-                switch (type) {
-                    case PAWN:
-                        attacks = game.attackWorker.preComputed.getPawnAttacks(them, square);
-                        break;
-                    case KNIGHT:
-                        attacks = game.attackWorker.preComputed.getKnightAttacks(square);
-                        break;
-                    case BISHOP:
-                        attacks = Magic::getBishopAttacks(square, occupancy);
-                        break;
-                    case ROOK:
-                        attacks = Magic::getRookAttacks(square, occupancy);
-                        break;
-                    case QUEEN:
-                        attacks = Magic::getQueenAttacks(square, occupancy);
-                        break;
-                    case KING:
-                        attacks = game.attackWorker.preComputed.getKingAttacks(square);
-                        break;
-                }
-
-                if (attacks & (1ULL << king_sq))
-                {
-                    checkers_bb |= (1ULL << square);
-                }
-            }
-        }
+        Bitboard checkers_bb = game.attackWorker.attackersTo(game, king_sq, occupancy, them);
 
         // Convert checkers bitboard to space-separated string
         while (checkers_bb)
@@ -293,92 +262,30 @@ namespace Board {
 
     void makeMove(Rune::Game& game, Move move, int callType)
     {
-        const int from = Helpers::get_from(move);
-        const int to   = Helpers::get_to(move);
-
-        const Piece piece = game.boardGhost[from];
-        const int color   = Helpers::get_color(piece);
-
-        const bool isEp        = Helpers::is_enpassant(move);
-        const int epCaptureSq = (color == WHITE) ? to - 8 : to + 8;
-        const Piece captured    = game.boardGhost[isEp ? epCaptureSq : to];
-
         // Save state
-        Rune::State *s = &game.history[game.historyCount++];
+        Rune::State *s = &game.pushState();
 
         s->castlingRights   = game.castlingRights;
         s->enpassantSquare  = game.enpassantSquare;
-        s->capturedPiece    = captured;
         s->move             = move;
         s->turn             = game.turn;
-        s->fiftyMoveCounter = game.repetitionTable.fiftyMoveCounter;
-
-        if (callType == MAKE_MOVE_FULL) s->zobristKey = game.zobristKey;
-
-        memcpy(s->attackMap, game.attackWorker.attackMap, sizeof(game.attackWorker.attackMap));
-        memcpy(s->attackMapFull, game.attackWorker.attackMapFull, sizeof(game.attackWorker.attackMapFull));
+        s->fiftyMoveCounter = game.fiftyMoveCounter;
+        s->zobristKey       = game.zobristKey;
 
-        // Zobrist update
-        if (callType == MAKE_MOVE_FULL) Zobrist::updateMove(game, move, *s);
+        // Apply move: pieces, castling rights, en passant, turn, counters & zobrist key
+        s->capturedPiece = game.makeMove(move);
 
-        // Apply move
-        setSquare(game, from, EMPTY);
-
-        if (Helpers::is_promo(move)) {
-            setSquare(game, to, Helpers::make_piece(Helpers::get_promo(move), color));
-        } else {
-            setSquare(game, to, piece);
-        }
-
-        if (isEp) setSquare(game, epCaptureSq, EMPTY);
-
-        // Castling — keep branch logic to preserve correctness
-        if (Helpers::is_castle(move)) {
-            int rookFrom = 0, rookTo = 0;
-
-            if (from == 4 && to == 6) {         // White kingside
-                rookFrom = 7;  rookTo = 5;
-            } else if (from == 60 && to == 62) { // Black kingside
-                rookFrom = 63; rookTo = 61;
-            } else if (from == 4 && to == 2) {   // White queenside
-                rookFrom = 0;  rookTo = 3;
-            } else if (from == 60 && to == 58) { // Black queenside
-                rookFrom = 56; rookTo = 59;
-            }
-
-            Piece rook = game.boardGhost[rookFrom];
-            setSquare(game, rookFrom, EMPTY);
-            setSquare(game, rookTo, rook);
-
-            game.hasCastled[color] = true;
-        }
-
-        // Update castling rights
-        game.castlingRights &= game.attackWorker.preComputed.castling[from][to];
-
-        // Update en passant square
-        game.enpassantSquare = Helpers::is_double_push(move) ? (color == WHITE ? to - 8 : to + 8) : -1;
-
-        // Incremental attack update
-        game.attackWorker.update(game, move);
-
-        // Switch turn
-        game.turn ^= 1;
-
-        // Increase ply
-        game.ply++;
+        // Incremental attack update, recording only the entries it changes
+        game.attackWorker.update(game, move, s->attackUndo);
 
         // Push repetition key
         if (callType == MAKE_MOVE_FULL)
         {
-            Zobrist::updateBoard(game);
-         
+            // Debug builds cross-check the incremental key against a full recompute
+            assert(game.zobristKey == Zobrist::compute(game));
+
             game.repetitionTable.push(game.zobristKey);
         }
-
-        if (Helpers::get_type(piece) == PAWN) game.repetitionTable.fiftyMoveCounter = 0;
-
-        else game.repetitionTable.fiftyMoveCounter++;
     }
 
     void unmakeMove(Rune::Game& game, int callType)
@@ -392,69 +299,23 @@ namespace Board {
 
         Rune::State *s = &game.history[--game.historyCount];
 
-        Move move = s->move;
-
-        const int from = Helpers::get_from(move);
-        const int to = Helpers::get_to(move);
-
-        Piece piece = game.boardGhost[to];
-
-        int color = Helpers::get_color(piece);
-
         // Undo turn flip first (since make_move flips at the end)
         game.turn = s->turn;
 
-        // Move piece back from `to` to `from`
-        setSquare(game, to, EMPTY);
-
-        if (Helpers::is_promo(move)) {
-            // On unmake, remove promoted piece at `to`, restore pawn at `from`
-            setSquare(game, from, Helpers::make_piece(PAWN, color));
-        } else {
-            setSquare(game, from, piece);
-        }
-
-        // Restore captured piece
-        if (Helpers::is_enpassant(move)) {
-            // Restore the captured pawn behind the `to` square
-            const int epCaptureSq = (color == WHITE) ? to - 8 : to + 8;
-
-            setSquare(game, epCaptureSq, s->capturedPiece);
-        } else if (s->capturedPiece != EMPTY) {
-            setSquare(game, to, s->capturedPiece);
-        }
-
-        // Undo castling rook move if castling
-        if (Helpers::is_castle(move))
-        {
-            int rookFrom, rookTo;
-            if (to == from + 2) {  // Kingside castle
-                rookFrom = from + 3;
-                rookTo = from + 1;
-            } else {               // Queenside castle
-                rookFrom = from - 4;
-                rookTo = from - 1;
-            }
-            Piece rook = game.boardGhost[rookTo];
-
-            setSquare(game, rookTo, EMPTY);
-            setSquare(game, rookFrom, rook);
-
-            game.hasCastled[color] = false;
-        }
+        // Put the pieces back the way this kind of move moved them
+        game.unmakeMove(s->move, s->capturedPiece);
 
         // Restore castling rights, en passant, zobrist key, and attack tables
         game.castlingRights = s->castlingRights;
         game.enpassantSquare = s->enpassantSquare;
 
-        if (callType == MAKE_MOVE_FULL) game.zobristKey = s->zobristKey;
+        game.zobristKey = s->zobristKey;
 
-        memcpy(game.attackWorker.attackMap, s->attackMap, sizeof(game.attackWorker.attackMap));
-        memcpy(game.attackWorker.attackMapFull, s->attackMapFull, sizeof(game.attackWorker.attackMapFull));
+        game.attackWorker.restore(s->attackUndo);
 
         if (callType == MAKE_MOVE_FULL) game.repetitionTable.pop();
 
-        game.repetitionTable.fiftyMoveCounter = s->fiftyMoveCounter;
+        game.fiftyMoveCounter = s->fiftyMoveCounter;
 
         game.ply--;
     }
@@ -462,21 +323,21 @@ namespace Board {
     void makeNullMove(Rune::Game& game)
     {
         // Save state
-        Rune::State *s = &game.history[game.historyCount++];
+        Rune::State *s = &game.pushState();
 
         s->castlingRights  = game.castlingRights;
         s->enpassantSquare = game.enpassantSquare;
         s->zobristKey      = game.zobristKey;
         s->turn            = game.turn;
+        s->fiftyMoveCounter = game.fiftyMoveCounter;
 
-        // Update en passant square
-        game.enpassantSquare = -1;
+        // Clear en passant, switch turn & update the key
+        game.makeNullMove();
 
-        // Switch turn
-        game.turn ^= 1;
+        // Pushes no repetition key, so repetition scans must not reach past it
+        game.fiftyMoveCounter = 0;
 
-        // Zobrist update
-        Zobrist::updateMove(game, 0, *s);
+        assert(game.zobristKey == Zobrist::compute(game));
     }
 
     void unmakeNullMove(Rune::Game& game)
@@ -493,6 +354,7 @@ namespace Board {
 
         game.enpassantSquare = s->enpassantSquare;
         game.zobristKey = s->zobristKey;
+        game.fiftyMoveCounter = s->fiftyMoveCounter;
     }
 
     bool isOnRank(int square, int rank)
@@ -605,35 +467,7 @@ namespace Board {
         if (Helpers::get_type(game.boardGhost[fromSq]) == KING && std::abs(toSq - fromSq) == 2)
             castle = true;
 
-        return Helpers::move(fromSq, toSq, promoFlag, capture, isPromo, enpassant, 0, doublePush, castle);
-    }
-
-    inline void setSquare(Rune::Game& game, int square, Piece piece)
-    {
-        const uint64_t bit = 1ULL << square;
-
-        Piece old_piece = game.boardGhost[square];
-        int old_type = Helpers::get_type(old_piece);
-
-        // Remove old piece
-        if (old_type != EMPTY) {
-            int old_color = Helpers::get_color(old_piece);
-            game.board[old_color][old_type] &= ~bit;
-            game.occupancy[old_color] &= ~bit;
-        }
-
-        // Place new piece
-        int new_type = Helpers::get_type(piece);
-        if (new_type != EMPTY) {
-            int new_color = Helpers::get_color(piece);
-            game.board[new_color][new_type] |= bit;
-            game.occupancy[new_color] |= bit;
-        }
-
-        game.boardGhost[square] = piece;
-
-        // Combined occupancy
-        game.occupancy[BOTH] = game.occupancy[WHITE] | game.occupancy[BLACK];
+        return Helpers::move(fromSq, toSq, promoFlag, capture, isPromo, enpassant, doublePush, castle);
     }
 
     bool hasCastlingRights(Rune::Game& game, int side)
@@ -692,18 +526,7 @@ namespace Board {
     {
         int kingSquare = findKing(game, color);
 
-        return (kingSquare < 0) ? false : (game.attackWorker.isSquareAttackedBy(kingSquare, !color));
-    }
-
-    bool moveGivesCheck(Rune::Game& game, Move move)
-    {
-        makeMove(game, move, MAKE_MOVE_LIGHT);
-
-        bool check = isKingInCheck(game, game.turn);
-
-        unmakeMove(game, MAKE_MOVE_LIGHT);
-
-        return check;
+        return (kingSquare < 0) ? false : (game.attackWorker.attackersTo(game, kingSquare, game.occupancy[BOTH], !color) != 0);
     }
 
     Bitboard getSlidingPiecesBitboard(Rune::Game& game, int color)
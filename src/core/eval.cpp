@@ -321,11 +321,16 @@ namespace Evaluation {
             // --- Enemy attacks into king zone ---
             int attackScore = 0;
 
+            // Only squares the incremental attack counts mark as attacked need an attackersTo lookup
+            Bitboard zoneAttackers = 0ULL;
+            Bitboard zone = kingZone & game.attackWorker.attackMapFull[!color];
+
+            while (zone)
+                zoneAttackers |= game.attackWorker.attackersTo(game, Helpers::pop_lsb(zone), game.occupancy[BOTH], !color);
+
             for (int piece = PAWN; piece <= QUEEN; piece++)
             {
-                Bitboard attackers = game.attackWorker.getAttackersForZone(game, kingZone, !color, piece);
-
-                int count = __builtin_popcountll(attackers);
+                int count = __builtin_popcountll(zoneAttackers & game.board[!color][piece]);
                 
                 attackScore += kingSafetyPieceDanger[piece] * count;
             }
@@ -11,235 +11,267 @@ namespace Rune {
 }
 
 namespace Movegen {
-    void Worker::addPromotionMoves(MoveList& moves, int from, int to, int isCapture)
+    // Constant-direction shift, negative shifts go down the board
+    template <int Direction>
+    static inline Bitboard shift(Bitboard bb)
     {
-        moves.add(Helpers::move(from, to, QUEEN, isCapture, 1, 0, 0, 0, 0));
-        moves.add(Helpers::move(from, to, ROOK, isCapture, 1, 0, 0, 0, 0));
-        moves.add(Helpers::move(from, to, BISHOP, isCapture, 1, 0, 0, 0, 0));
-        moves.add(Helpers::move(from, to, KNIGHT, isCapture, 1, 0, 0, 0, 0));
+        return (Direction > 0) ? (bb << Direction) : (bb >> -Direction);
     }
 
-    void Worker::getPawnMoves(Rune::Game& game, MoveList& moves, bool onlyCaptures)
+    void Worker::addPromotionMoves(MoveList& moves, int from, int to, int isCapture)
     {
-        int color = game.turn;
+        int kind = MOVE_PROMOTION | (isCapture ? MOVE_CAPTURE : 0);
 
-        Bitboard ownOcc = game.occupancy[color];
-        Bitboard oppOcc = game.occupancy[!color];
-        Bitboard allOcc = ownOcc | oppOcc;
+        moves.add(Helpers::make_move(from, to, kind | (QUEEN - KNIGHT)));
+        moves.add(Helpers::make_move(from, to, kind | (ROOK - KNIGHT)));
+        moves.add(Helpers::make_move(from, to, kind | (BISHOP - KNIGHT)));
+        moves.add(Helpers::make_move(from, to, kind));
+    }
 
-        Bitboard pawns = game.board[color][PAWN];
+    // -------------------------
+    // Specialized generators
+    // -------------------------
+    template <int Color, GenType Type>
+    void Worker::generatePawnMoves(Rune::Game& game, MoveList& moves, Bitboard pawns, Bitboard targets)
+    {
+        constexpr int Up        = (Color == WHITE) ? 8 : -8;
+        constexpr int UpWest    = (Color == WHITE) ? 7 : -9;
+        constexpr int UpEast    = (Color == WHITE) ? 9 : -7;
+        constexpr Bitboard DoublePushRank = (Color == WHITE) ? RANK_3 : RANK_6;
+        constexpr Bitboard PromotionRank  = (Color == WHITE) ? RANK_8 : RANK_1;
 
-        int pushDir = (color == WHITE) ? 8 : -8;
-        int dblPushDir = (color == WHITE) ? 16 : -16;
-        Bitboard promoteMask = (color == WHITE) ? RANK_8 : RANK_1;
-        Bitboard startRankMask = (color == WHITE) ? RANK_2 : RANK_7;
+        const Bitboard empty = ~game.occupancy[BOTH];
+        const Bitboard enemy = game.occupancy[!Color];
 
-        while (pawns)
+        // Pushes
+        if constexpr (Type != CAPTURES)
         {
-            int from = __builtin_ctzll(pawns);
-            pawns &= pawns - 1;
-            Bitboard fromBb = 1ULL << from;
+            Bitboard single = shift<Up>(pawns) & empty;
+            Bitboard dbl    = shift<Up>(single & DoublePushRank) & empty & targets;
+
+            single &= targets;
 
-            // Quiet moves
-            if (!onlyCaptures)
+            Bitboard promotions = single & PromotionRank;
+            single &= ~PromotionRank;
+
+            while (single)
+            {
+                int to = Helpers::pop_lsb(single);
+                moves.add(Helpers::make_move(to - Up, to, MOVE_QUIET));
+            }
+
+            while (dbl)
             {
-                int toSq = from + pushDir;
-                if (toSq >= 0 && toSq < 64)
+                int to = Helpers::pop_lsb(dbl);
+                moves.add(Helpers::make_move(to - 2 * Up, to, MOVE_DOUBLE_PUSH));
+            }
+
+            if constexpr (Type != QUIET_CHECKS)
+            {
+                while (promotions)
                 {
-                    Bitboard toBb = 1ULL << toSq;
-                    if (!(toBb & allOcc))
-                    {
-                        if (toBb & promoteMask)
-                            addPromotionMoves(moves, from, toSq, 0);
-                        else
-                            moves.add(Helpers::move(from, toSq, 0, 0, 0, 0, 0, 0, 0));
-
-                        // Double push (check intermediate square)
-                        if (fromBb & startRankMask)
-                        {
-                            int toSq2 = from + dblPushDir;
-                            if (toSq2 >= 0 && toSq2 < 64)
-                            {
-                                Bitboard toBb2 = 1ULL << toSq2;
-                                if (!(toBb2 & allOcc) && !(toBb & allOcc))
-                                    moves.add(Helpers::move(from, toSq2, 0, 0, 0, 0, 0, 1, 0));
-                            }
-                        }
-                    }
+                    int to = Helpers::pop_lsb(promotions);
+                    addPromotionMoves(moves, to - Up, to, 0);
                 }
             }
+        }
+
+        // Captures
+        if constexpr (Type != QUIETS && Type != QUIET_CHECKS)
+        {
+            Bitboard west = shift<UpWest>(pawns & ~FILE_A) & enemy & targets;
+            Bitboard east = shift<UpEast>(pawns & ~FILE_H) & enemy & targets;
+
+            while (west)
+            {
+                int to = Helpers::pop_lsb(west);
 
-            // Captures
-            Bitboard leftCaptures, rightCaptures;
-            if (color == WHITE) {
-                leftCaptures  = (fromBb & ~FILE_A) << 7;
-                rightCaptures = (fromBb & ~FILE_H) << 9;
-            } else {
-                leftCaptures  = (fromBb & ~FILE_A) >> 9;
-                rightCaptures = (fromBb & ~FILE_H) >> 7;
+                if ((1ULL << to) & PromotionRank) addPromotionMoves(moves, to - UpWest, to, 1);
+                else moves.add(Helpers::make_move(to - UpWest, to, MOVE_CAPTURE));
             }
 
-            Bitboard attacks = (leftCaptures | rightCaptures) & oppOcc;
-            while (attacks)
+            while (east)
             {
-                int toSq = __builtin_ctzll(attacks);
-                attacks &= attacks - 1;
+                int to = Helpers::pop_lsb(east);
 
-                if ((1ULL << toSq) & promoteMask)
-                    addPromotionMoves(moves, from, toSq, 1);
-                else
-                    moves.add(Helpers::move(from, toSq, 0, 1, 0, 0, 0, 0, 0));
+                if ((1ULL << to) & PromotionRank) addPromotionMoves(moves, to - UpEast, to, 1);
+                else moves.add(Helpers::make_move(to - UpEast, to, MOVE_CAPTURE));
             }
 
-            // En passant (king safety must still be checked in legal move filtering)
+            // En passant (king safety is checked by the legality filter)
             if (game.enpassantSquare != -1)
             {
-                Bitboard epBb = 1ULL << game.enpassantSquare;
-                if ((leftCaptures & epBb) || (rightCaptures & epBb))
-                    moves.add(Helpers::move(from, game.enpassantSquare, 0, 1, 0, 1, 0, 0, 0));
+                Bitboard epPawns = pawns & game.attackWorker.preComputed.pawns[!Color][game.enpassantSquare];
+
+                while (epPawns)
+                {
+                    int from = Helpers::pop_lsb(epPawns);
+                    moves.add(Helpers::make_move(from, game.enpassantSquare, MOVE_ENPASSANT));
+                }
             }
         }
     }
 
-    void Worker::getKnightMoves(Rune::Game& game, MoveList& moves, bool onlyCaptures)
+    template <int Color, int Piece, GenType Type>
+    void Worker::generatePieceMoves(Rune::Game& game, MoveList& moves, Bitboard pieces, Bitboard targets)
     {
-        int color = game.turn;
+        const PrecomputedTables::AttackTable& table = game.attackWorker.preComputed;
 
-        Bitboard knights = game.board[color][KNIGHT];
-        Bitboard friendly = game.occupancy[color];
-        Bitboard oppOccupancy = game.occupancy[!color];
+        const Bitboard occupancy = game.occupancy[BOTH];
+        const Bitboard enemy = game.occupancy[!Color];
 
-        while (knights)
+        while (pieces)
         {
-            int square = __builtin_ctzll(knights);
-            knights &= knights - 1;
+            int from = Helpers::pop_lsb(pieces);
 
-            // Precomputed attacks for the knight, remove friendly squares
-            Bitboard attacks = game.attackWorker.preComputed.getKnightAttacks(square) & ~friendly;
+            Bitboard attacks;
 
-            if (onlyCaptures)
-            {
-                // Keep only opponent pieces
-                attacks &= oppOccupancy;
-            }
+            if constexpr (Piece == KNIGHT)      attacks = table.pieces[KNIGHT][from];
+            else if constexpr (Piece == BISHOP) attacks = Magic::getBishopAttacks(from, occupancy);
+            else if constexpr (Piece == ROOK)   attacks = Magic::getRookAttacks(from, occupancy);
+            else if constexpr (Piece == QUEEN)  attacks = Magic::getQueenAttacks(from, occupancy);
+            else                                attacks = table.pieces[KING][from];
+
+            attacks &= targets;
 
-            // Iterate over all attacks safely
             while (attacks)
             {
-                int to = __builtin_ctzll(attacks);
-                attacks &= attacks - 1;  // clear the bit to avoid infinite loop
+                int to = Helpers::pop_lsb(attacks);
 
-                int isCapture = (oppOccupancy >> to) & 1ULL;
-                moves.add(Helpers::move(square, to, 0, isCapture, 0, 0, 0, 0, 0));
+                int isCapture;
+
+                if constexpr (Type == CAPTURES) isCapture = 1;
+                else if constexpr (Type == QUIETS || Type == QUIET_CHECKS) isCapture = 0;
+                else isCapture = (enemy >> to) & 1ULL;
+
+                moves.add(Helpers::make_move(from, to, isCapture ? MOVE_CAPTURE : MOVE_QUIET));
             }
         }
     }
 
-    void Worker::getKingMoves(Rune::Game& game, MoveList& moves, bool onlyCaptures)
+    template <int Color, GenType Type>
+    void Worker::generateAll(Rune::Game& game, MoveList& moves, Bitboard targets, Bitboard kingTargets)
     {
-        int color = game.turn;
+        generatePawnMoves<Color, Type>(game, moves, game.board[Color][PAWN], targets);
+        generatePieceMoves<Color, KNIGHT, Type>(game, moves, game.board[Color][KNIGHT], targets);
+        generatePieceMoves<Color, KING, Type>(game, moves, game.board[Color][KING], kingTargets);
 
-        Bitboard king = game.board[color][KING];
-        Bitboard friendly = game.occupancy[color];
-        Bitboard oppOccupancy = game.occupancy[!color];
+        generatePieceMoves<Color, BISHOP, Type>(game, moves, game.board[Color][BISHOP], targets);
+        generatePieceMoves<Color, ROOK, Type>(game, moves, game.board[Color][ROOK], targets);
+        generatePieceMoves<Color, QUEEN, Type>(game, moves, game.board[Color][QUEEN], targets);
 
-        while (king)
-        {
-            int square = __builtin_ctzll(king);
+        if constexpr (Type == QUIETS || Type == ALL) getCastleMoves(game, moves);
+    }
 
-            king &= king - 1;
+    template <int Color>
+    void Worker::generateEvasions(Rune::Game& game, MoveList& moves, int kingSquare, Bitboard checkers)
+    {
+        // The king can always try to step away
+        generatePieceMoves<Color, KING, EVASIONS>(game, moves, game.board[Color][KING], ~game.occupancy[Color]);
 
-            Bitboard attacks = game.attackWorker.preComputed.getKingAttacks(square) & ~friendly;
+        // Double check: only the king can move
+        if (checkers & (checkers - 1)) return;
 
-            if (onlyCaptures)
-            {
-                attacks &= oppOccupancy;
+        // Single check: capture the checker or block between it and the king
+        Bitboard targets = checkers | game.attackWorker.preComputed.between[kingSquare][__builtin_ctzll(checkers)];
 
-                while (attacks)
-                {
-                    int to = __builtin_ctzll(attacks);
+        generatePawnMoves<Color, EVASIONS>(game, moves, game.board[Color][PAWN], targets);
+        generatePieceMoves<Color, KNIGHT, EVASIONS>(game, moves, game.board[Color][KNIGHT], targets);
 
-                    attacks &= attacks - 1;
+        generatePieceMoves<Color, BISHOP, EVASIONS>(game, moves, game.board[Color][BISHOP], targets);
+        generatePieceMoves<Color, ROOK, EVASIONS>(game, moves, game.board[Color][ROOK], targets);
+        generatePieceMoves<Color, QUEEN, EVASIONS>(game, moves, game.board[Color][QUEEN], targets);
+    }
 
-                    moves.add(Helpers::move(square, to, 0, 1, 0, 0, 0, 0, 0));
-                }
-            }
-            else
-            {
-                while (attacks)
-                {
-                    int to = __builtin_ctzll(attacks);
-                    int isCapture = (oppOccupancy >> to) & 1ULL;
+    template <int Color>
+    void Worker::generateQuietChecks(Rune::Game& game, MoveList& moves)
+    {
+        CheckInfo info;
+        getCheckInfo(game, info);
 
-                    attacks &= attacks - 1;
+        if (info.kingSquare < 0) return;
 
-                    moves.add(Helpers::move(square, to, 0, isCapture, 0, 0, 0, 0, 0));
-                }
-            }
-        }
-    }
+        const PrecomputedTables::AttackTable& table = game.attackWorker.preComputed;
 
-    void Worker::getSlidingMoves(Rune::Game& game, MoveList& moves, PieceType type, bool onlyCaptures)
-    {
-        int color = game.turn;
-        
-        Bitboard sliders = game.board[color][type];
-        Bitboard occupancy = game.occupancy[BOTH];
-        Bitboard friendly = game.occupancy[color];
-        Bitboard oppOccupancy = game.occupancy[!color];
+        const int enemyKing = info.kingSquare;
+        const Bitboard* checkSquares = info.checkSquares;
+        const Bitboard discovered = info.discovered;
+        const Bitboard empty = ~game.occupancy[BOTH];
 
-        while (sliders)
-        {
-            int from = __builtin_ctzll(sliders);
+        // Direct checks
+        generatePawnMoves<Color, QUIET_CHECKS>(game, moves, game.board[Color][PAWN] & ~discovered, empty & checkSquares[PAWN]);
+        generatePieceMoves<Color, KNIGHT, QUIET_CHECKS>(game, moves, game.board[Color][KNIGHT] & ~discovered, empty & checkSquares[KNIGHT]);
+        generatePieceMoves<Color, BISHOP, QUIET_CHECKS>(game, moves, game.board[Color][BISHOP] & ~discovered, empty & checkSquares[BISHOP]);
+        generatePieceMoves<Color, ROOK, QUIET_CHECKS>(game, moves, game.board[Color][ROOK] & ~discovered, empty & checkSquares[ROOK]);
+        generatePieceMoves<Color, QUEEN, QUIET_CHECKS>(game, moves, game.board[Color][QUEEN] & ~discovered, empty & checkSquares[QUEEN]);
+
+        // Discovered checks, a candidate may also check directly from its new square
+        Bitboard candidates = discovered;
 
-            sliders &= sliders - 1;
+        while (candidates)
+        {
+            int from = Helpers::pop_lsb(candidates);
 
-            Bitboard attacks = 0ULL;
+            Bitboard piece = 1ULL << from;
+            Bitboard offLine = ~table.line[enemyKing][from];
 
-            switch (type)
+            switch (Helpers::get_type(game.boardGhost[from]))
             {
-                case BISHOP:
-                    attacks = Magic::getBishopAttacks(from, occupancy);
-                    break;
-                case ROOK:
-                    attacks = Magic::getRookAttacks(from, occupancy);
-                    break;
-                case QUEEN:
-                    attacks = Magic::getQueenAttacks(from, occupancy);
-                    break;
-                default:
-                    continue; // Not a sliding piece
+                case PAWN:   generatePawnMoves<Color, QUIET_CHECKS>(game, moves, piece, empty & (offLine | checkSquares[PAWN])); break;
+                case KNIGHT: generatePieceMoves<Color, KNIGHT, QUIET_CHECKS>(game, moves, piece, empty); break;
+                case BISHOP: generatePieceMoves<Color, BISHOP, QUIET_CHECKS>(game, moves, piece, empty & (offLine | checkSquares[BISHOP])); break;
+                case ROOK:   generatePieceMoves<Color, ROOK, QUIET_CHECKS>(game, moves, piece, empty & (offLine | checkSquares[ROOK])); break;
+                case QUEEN:  generatePieceMoves<Color, QUEEN, QUIET_CHECKS>(game, moves, piece, empty & (offLine | checkSquares[QUEEN])); break;
+                case KING:   generatePieceMoves<Color, KING, QUIET_CHECKS>(game, moves, piece, empty & offLine); break;
+                default: break;
             }
+        }
+    }
 
-            // Remove own pieces
-            attacks &= ~friendly;
+    template <GenType Type>
+    void Worker::generate(Rune::Game& game, MoveList& moves)
+    {
+        const int color = game.turn;
 
-            if (onlyCaptures) {
-                // Captures only → keep only opponent pieces
-                Bitboard caps = attacks & oppOccupancy;
+        if constexpr (Type == EVASIONS)
+        {
+            if (!game.board[color][KING]) return;
 
-                while (caps)
-                {
-                    int to = __builtin_ctzll(caps);
+            int kingSquare = __builtin_ctzll(game.board[color][KING]);
+            Bitboard checkers = game.attackWorker.attackersTo(game, kingSquare, game.occupancy[BOTH], !color);
 
-                    caps &= caps - 1;
+            if (!checkers) return;
 
-                    moves.add(Helpers::move(from, to, 0, 1, 0, 0, 0, 0, 0));
-                }
-            } else {
-                while (attacks)
-                {
-                    int to = __builtin_ctzll(attacks);
-                    int is_capture = (oppOccupancy >> to) & 1ULL;
+            if (color == WHITE) generateEvasions<WHITE>(game, moves, kingSquare, checkers);
+            else                generateEvasions<BLACK>(game, moves, kingSquare, checkers);
+        }
+        else if constexpr (Type == QUIET_CHECKS)
+        {
+            if (color == WHITE) generateQuietChecks<WHITE>(game, moves);
+            else                generateQuietChecks<BLACK>(game, moves);
+        }
+        else
+        {
+            Bitboard targets;
 
-                    attacks &= attacks - 1;
+            if constexpr (Type == CAPTURES)    targets = game.occupancy[!color];
+            else if constexpr (Type == QUIETS) targets = ~game.occupancy[BOTH];
+            else                               targets = ~game.occupancy[color];
 
-                    moves.add(Helpers::move(from, to, 0, is_capture, 0, 0, 0, 0, 0));
-                }
-            }
+            if (color == WHITE) generateAll<WHITE, Type>(game, moves, targets, targets);
+            else                generateAll<BLACK, Type>(game, moves, targets, targets);
         }
     }
 
+    template void Worker::generate<CAPTURES>(Rune::Game& game, MoveList& moves);
+    template void Worker::generate<QUIETS>(Rune::Game& game, MoveList& moves);
+    template void Worker::generate<EVASIONS>(Rune::Game& game, MoveList& moves);
+    template void Worker::generate<QUIET_CHECKS>(Rune::Game& game, MoveList& moves);
+    template void Worker::generate<ALL>(Rune::Game& game, MoveList& moves);
+
+    // -------------------------
+    // Castling
+    // -------------------------
     bool Worker::canCastleThroughBitboard(int square, Bitboard occupancy, Bitboard enemyAttacks)
     {
         return !((occupancy >> square) & 1ULL) && !((enemyAttacks >> square) & 1ULL);
@@ -270,7 +302,7 @@ namespace Movegen {
             if (canCastleThroughBitboard(f_sq, occupied, enemyAttacks) &&
                 canCastleThroughBitboard(g_sq, occupied, enemyAttacks))
             {
-                moves.add(Helpers::move(kingSquare, g_sq, 0, 0, 0, 0, 0, 0, 1));
+                moves.add(Helpers::make_move(kingSquare, g_sq, MOVE_CASTLE));
             }
         }
 
@@ -286,7 +318,7 @@ namespace Movegen {
                 canCastleThroughBitboard(c_sq, occupied, enemyAttacks) &&
                 !((occupied >> b_sq) & 1ULL))
             {
-                moves.add(Helpers::move(kingSquare, c_sq, 0, 0, 0, 0, 0, 0, 1));
+                moves.add(Helpers::make_move(kingSquare, c_sq, MOVE_CASTLE));
             }
         }
     }
@@ -295,24 +327,206 @@ namespace Movegen {
     {
         moves.clear();
 
-        getPawnMoves(game, moves, onlyCaptures);
-        getKnightMoves(game, moves, onlyCaptures);
-        getKingMoves(game, moves, onlyCaptures);
+        if (onlyCaptures) generate<CAPTURES>(game, moves);
+        else              generate<ALL>(game, moves);
+    }
 
-        getSlidingMoves(game, moves, BISHOP, onlyCaptures);
-        getSlidingMoves(game, moves, ROOK, onlyCaptures);
-        getSlidingMoves(game, moves, QUEEN, onlyCaptures);
+    void Worker::getEvasionMoves(Rune::Game& game, MoveList& moves, int kingSquare, Bitboard checkers, bool onlyCaptures)
+    {
+        moves.clear();
 
-        if (!onlyCaptures) getCastleMoves(game, moves);
+        if (game.turn == WHITE) generateEvasions<WHITE>(game, moves, kingSquare, checkers);
+        else                    generateEvasions<BLACK>(game, moves, kingSquare, checkers);
+
+        if (!onlyCaptures) return;
+
+        // Captures-only requests keep the capturing evasions
+        int captureCount = 0;
+
+        for (int i = 0; i < moves.size(); i++)
+        {
+            if (Helpers::is_capture(moves[i])) moves[captureCount++] = moves[i];
+        }
+
+        moves.setsize(captureCount);
+    }
+
+    Bitboard Worker::getBlockers(Rune::Game& game, int square, int sliderColor, int blockerColor)
+    {
+        const PrecomputedTables::AttackTable& table = game.attackWorker.preComputed;
+
+        // Sliders that would hit the square on an empty board
+        Bitboard snipers =
+            (table.pieces[BISHOP][square] & (game.board[sliderColor][BISHOP] | game.board[sliderColor][QUEEN])) |
+            (table.pieces[ROOK][square]   & (game.board[sliderColor][ROOK]   | game.board[sliderColor][QUEEN]));
+
+        Bitboard blockersFound = 0ULL;
+
+        while (snipers)
+        {
+            int sniper = Helpers::pop_lsb(snipers);
+
+            Bitboard blockers = table.between[square][sniper] & game.occupancy[BOTH];
+
+            // Exactly one blocker, and it has the requested color
+            if (blockers && !(blockers & (blockers - 1)))
+                blockersFound |= blockers & game.occupancy[blockerColor];
+        }
+
+        return blockersFound;
+    }
+
+    bool Worker::isLegal(Rune::Game& game, Move move, int kingSquare, Bitboard pinned, Bitboard checkTargets)
+    {
+        const int from  = Helpers::get_from(move);
+        const int to    = Helpers::get_to(move);
+        const int color = game.turn;
+
+        // King moves: the destination must be safe once the king has left its square
+        if (from == kingSquare)
+        {
+            // Castling already checked the king and the squares it crosses
+            if (Helpers::is_castle(move)) return true;
+
+            return !game.attackWorker.attackersTo(game, to, game.occupancy[BOTH] ^ (1ULL << from), !color);
+        }
+
+        // En passant removes two pawns from one rank, test the resulting board directly
+        if (Helpers::is_enpassant(move))
+        {
+            int capturedSquare = (color == WHITE) ? to - 8 : to + 8;
+
+            Bitboard occupancy = (game.occupancy[BOTH] ^ (1ULL << from) ^ (1ULL << capturedSquare)) | (1ULL << to);
+
+            return !(game.attackWorker.attackersTo(game, kingSquare, occupancy, !color) & ~(1ULL << capturedSquare));
+        }
+
+        // In check: capture the checker or block its ray
+        if (!((checkTargets >> to) & 1ULL)) return false;
+
+        // Pinned pieces stay on the line through their king
+        if ((pinned >> from) & 1ULL)
+            return (game.attackWorker.preComputed.line[kingSquare][from] >> to) & 1ULL;
+
+        return true;
+    }
+
+    void Worker::getCheckInfo(Rune::Game& game, CheckInfo& info)
+    {
+        const PrecomputedTables::AttackTable& table = game.attackWorker.preComputed;
+
+        const int color = game.turn;
+
+        info = CheckInfo();
+
+        if (!game.board[!color][KING]) return;
+
+        const int enemyKing = __builtin_ctzll(game.board[!color][KING]);
+        const Bitboard occupancy = game.occupancy[BOTH];
+
+        info.kingSquare = enemyKing;
+
+        info.checkSquares[PAWN]   = table.pawns[!color][enemyKing];
+        info.checkSquares[KNIGHT] = table.pieces[KNIGHT][enemyKing];
+        info.checkSquares[BISHOP] = Magic::getBishopAttacks(enemyKing, occupancy);
+        info.checkSquares[ROOK]   = Magic::getRookAttacks(enemyKing, occupancy);
+        info.checkSquares[QUEEN]  = info.checkSquares[BISHOP] | info.checkSquares[ROOK];
+
+        info.discovered = getBlockers(game, enemyKing, color, color);
+    }
+
+    bool Worker::givesCheck(Rune::Game& game, Move move, const CheckInfo& info)
+    {
+        if (info.kingSquare < 0) return false;
+
+        const PrecomputedTables::AttackTable& table = game.attackWorker.preComputed;
+
+        const int color = game.turn;
+        const int from  = Helpers::get_from(move);
+        const int to    = Helpers::get_to(move);
+        const int type  = Helpers::get_type(game.boardGhost[from]);
+
+        const Bitboard kingBb = 1ULL << info.kingSquare;
+
+        // Direct check from the destination
+        if (info.checkSquares[type] & (1ULL << to)) return true;
+
+        // Discovered check: the piece leaves the line between a slider and the king
+        if ((info.discovered & (1ULL << from)) && !(table.line[info.kingSquare][from] & (1ULL << to)))
+            return true;
+
+        // En passant: the captured pawn leaves too, which may open a second line
+        if (Helpers::is_enpassant(move))
+        {
+            const int captureSq = (color == WHITE) ? to - 8 : to + 8;
+            const Bitboard occupancy = (game.occupancy[BOTH] ^ (1ULL << from) ^ (1ULL << captureSq)) | (1ULL << to);
+
+            return (Magic::getBishopAttacks(info.kingSquare, occupancy) & (game.board[color][BISHOP] | game.board[color][QUEEN])) ||
+                   (Magic::getRookAttacks(info.kingSquare, occupancy)   & (game.board[color][ROOK]   | game.board[color][QUEEN]));
+        }
+
+        // Castling: only the rook can check, seen from its new square with the king moved
+        if (Helpers::is_castle(move))
+        {
+            const int rookFrom = PrecomputedTables::castlingRooks.from[to];
+            const int rookTo   = PrecomputedTables::castlingRooks.to[to];
+            const Bitboard occupancy = (game.occupancy[BOTH] ^ (1ULL << from) ^ (1ULL << rookFrom)) | (1ULL << to) | (1ULL << rookTo);
+
+            return (Magic::getRookAttacks(rookTo, occupancy) & kingBb) != 0;
+        }
+
+        // Promotion: the new piece attacks with the pawn gone from its square
+        if (Helpers::is_promo(move))
+        {
+            const Bitboard occupancy = game.occupancy[BOTH] ^ (1ULL << from);
+
+            switch (Helpers::get_promo(move))
+            {
+                case KNIGHT: return (table.pieces[KNIGHT][to] & kingBb) != 0;
+                case BISHOP: return (Magic::getBishopAttacks(to, occupancy) & kingBb) != 0;
+                case ROOK:   return (Magic::getRookAttacks(to, occupancy) & kingBb) != 0;
+                case QUEEN:  return (Magic::getQueenAttacks(to, occupancy) & kingBb) != 0;
+                default:     return false;
+            }
+        }
+
+        return false;
     }
 
     void Worker::getLegalMoves(Rune::Game& game, MoveList& moves, bool onlyCaptures)
     {
         moves.clear();
-        
-        getPseudoMoves(game, moves, onlyCaptures || game.config.moveGen.doOnlyCaptures);
 
-        if (!game.config.moveGen.doLegalMoveFiltering) return;
+        const int color = game.turn;
+        const bool captures = onlyCaptures || game.config.moveGen.doOnlyCaptures;
+
+        if (!game.config.moveGen.doLegalMoveFiltering || !game.board[color][KING])
+        {
+            getPseudoMoves(game, moves, captures);
+            return;
+        }
+
+        // Checkers and pins are computed once, every move is then tested without make/unmake
+        const int kingSquare = __builtin_ctzll(game.board[color][KING]);
+        const Bitboard checkers = game.attackWorker.attackersTo(game, kingSquare, game.occupancy[BOTH], !color);
+        const Bitboard pinned = getBlockers(game, kingSquare, !color, color);
+
+        // In check only moves that can answer it are generated
+        if (checkers)
+            getEvasionMoves(game, moves, kingSquare, checkers, captures);
+        else
+            getPseudoMoves(game, moves, captures);
+
+        // Where a non-king move has to land: anywhere, on the checker or its ray, nowhere in double check
+        Bitboard checkTargets = ~0ULL;
+
+        if (checkers)
+        {
+            if (checkers & (checkers - 1))
+                checkTargets = 0ULL;
+            else
+                checkTargets = checkers | game.attackWorker.preComputed.between[kingSquare][__builtin_ctzll(checkers)];
+        }
 
         int legalMoveCount = 0;
 
@@ -320,20 +534,78 @@ namespace Movegen {
         {
             Move move = moves[i];
 
-            Board::makeMove(game, move, MAKE_MOVE_LIGHT);
-
-            if (!Board::isKingInCheck(game, !game.turn))
+            if (isLegal(game, move, kingSquare, pinned, checkTargets))
             {
                 moves[legalMoveCount] = move;
 
                 legalMoveCount++;
             }
+        }
+
+        moves.setsize(legalMoveCount);
+    }
+
+    void Worker::getLegalChecks(Rune::Game& game, MoveList& moves)
+    {
+        moves.clear();
+
+        const int color = game.turn;
+
+        CheckInfo checkInfo;
+        getCheckInfo(game, checkInfo);
+
+        Bitboard checkers = 0ULL;
+
+        if (game.board[color][KING])
+            checkers = game.attackWorker.attackersTo(game, __builtin_ctzll(game.board[color][KING]), game.occupancy[BOTH], !color);
+
+        // In check the evasions are few enough to filter, the same goes for pseudo-legal or kingless setups
+        if (checkers || !game.config.moveGen.doLegalMoveFiltering || !game.board[color][KING])
+        {
+            getLegalMoves(game, moves, false);
+
+            int checkCount = 0;
+
+            for (int i = 0; i < moves.size(); i++)
+            {
+                if (givesCheck(game, moves[i], checkInfo)) moves[checkCount++] = moves[i];
+            }
+
+            moves.setsize(checkCount);
+            return;
+        }
+
+        const int kingSquare = __builtin_ctzll(game.board[color][KING]);
+        const Bitboard pinned = getBlockers(game, kingSquare, !color, color);
+
+        generate<CAPTURES>(game, moves);
+        generate<QUIET_CHECKS>(game, moves);
+
+        // Quiet promotions and castling are left out of QUIET_CHECKS, only look for them when they can exist
+        const Bitboard promotionRank = (color == WHITE) ? RANK_7 : RANK_2;
+        const CastlingRights ownRights = (color == WHITE) ? (WHITE_KINGSIDE | WHITE_QUEENSIDE) : (BLACK_KINGSIDE | BLACK_QUEENSIDE);
+
+        if ((game.board[color][PAWN] & promotionRank) || (game.castlingRights & ownRights))
+        {
+            MoveList quiets;
+            generate<QUIETS>(game, quiets);
+
+            for (int i = 0; i < quiets.size(); i++)
+            {
+                if (Helpers::is_promo(quiets[i]) || Helpers::is_castle(quiets[i])) moves.add(quiets[i]);
+            }
+        }
 
-            Board::unmakeMove(game, MAKE_MOVE_LIGHT);
+        int legalCheckCount = 0;
 
-            continue;
+        for (int i = 0; i < moves.size(); i++)
+        {
+            Move move = moves[i];
+
+            if (isLegal(game, move, kingSquare, pinned, ~0ULL) && givesCheck(game, move, checkInfo))
+                moves[legalCheckCount++] = move;
         }
 
-        moves.setsize(legalMoveCount);
+        moves.setsize(legalCheckCount);
     }
 }
\ No newline at end of file
@@ -2,13 +2,62 @@
 #include <core/board.hpp>
 #include <core/perft.hpp>
 #include <core/rune.hpp>
+#include <core/search.hpp>
+#include <tables/magic.hpp>
 
 #include <cstdio>
 #include <cstdlib>
 #include <ctime>
 #include <cstring>
+#include <random>
 
 namespace Perft {
+    // You can expand this number if you add more tests
+    constexpr int PERFT_TEST_COUNT = 8;
+
+    struct PerftTest {
+        const char* fen;
+        long long expected_nodes[8]; // store up to 8 depths
+        int start_depth;
+        int end_depth;
+    };
+
+    const PerftTest tests[PERFT_TEST_COUNT] = {
+        {
+            "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+            {20,400,8902,197281,4865609}, 1, 5
+        },
+        {
+            "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq -",
+            {48,2039,97862,4085603}, 1, 4
+        },
+        {
+            "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+            {14,191,2812,43238,674624,11030083}, 1, 6
+        },
+        {
+            "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+            {6,264,9467,422333,15833292}, 1, 5
+        },
+        {
+            "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+            {44,1486,62379,2103487}, 1, 4
+        },
+        {
+            "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+            {46,2079,89890,3894594}, 1, 4
+        },
+        // extra perft test (kiwipete)
+        {
+            "rnbq1rk1/ppp1bppp/3ppn2/8/3NP3/2N1BP2/PPP2QPP/R3KB1R w KQ - 4 8",
+            {45,1165,52511,1419625}, 1, 4
+        },
+        // extra perft test (simple endgame)
+        {
+            "8/8/8/3k4/8/8/4K3/8 w - - 0 1",
+            {8, 58, 368, 2759, 18692, 142426, 944323, 6820526}, 1, 8
+        }
+    };
 
     // Recursive perft: counts all leaf nodes
     long long perft(Rune::Game& game, int depth)
@@ -82,53 +131,6 @@ namespace Perft {
     // Automated perft tests
     void runTests(Rune::Game& game)
     {
-        // You can expand this number if you add more tests
-        constexpr int PERFT_TEST_COUNT = 8;
-
-        struct PerftTest {
-            const char* fen;
-            long long expected_nodes[8]; // store up to 8 depths
-            int start_depth;
-            int end_depth;
-        };
-
-        PerftTest tests[PERFT_TEST_COUNT] = {
-            {
-                "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
-                {20,400,8902,197281,4865609}, 1, 5
-            },
-            {
-                "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq -",
-                {48,2039,97862,4085603}, 1, 4
-            },
-            {
-                "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
-                {14,191,2812,43238,674624,11030083}, 1, 6
-            },
-            {
-                "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
-                {6,264,9467,422333,15833292}, 1, 5
-            },
-            {
-                "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
-                {44,1486,62379,2103487}, 1, 4
-            },
-            {
-                "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
-                {46,2079,89890,3894594}, 1, 4
-            },
-            // extra perft test (kiwipete)
-            {
-                "rnbq1rk1/ppp1bppp/3ppn2/8/3NP3/2N1BP2/PPP2QPP/R3KB1R w KQ - 4 8",
-                {45,1165,52511,1419625}, 1, 4
-            },
-            // extra perft test (simple endgame)
-            {
-                "8/8/8/3k4/8/8/4K3/8 w - - 0 1",
-                {8, 58, 368, 2759, 18692, 142426, 944323, 6820526}, 1, 8
-            }
-        };
-
         std::clock_t start_total = std::clock();
         printf("\n========== PERFT TESTS START ==========\n");
 
@@ -136,7 +138,7 @@ namespace Perft {
 
         for (int idx = 0; idx < PERFT_TEST_COUNT && allPassed; ++idx)
         {
-            PerftTest& test = tests[idx];
+            const PerftTest& test = tests[idx];
             printf("\n--- Test %d: FEN ---\n%s\n", idx+1, test.fen);
 
             for (int depth = test.start_depth; depth <= test.end_depth; ++depth)
@@ -165,4 +167,460 @@ namespace Perft {
         printf("Total time: %.2f ms\n\n", total_time_ms);
     }
 
-} // namespace Perft
\ No newline at end of file
+    // True when the incremental attack maps equal a full rebuild, the incremental state is kept
+    static bool attacksMatch(Rune::Game& game)
+    {
+        Attack::Worker& worker = game.attackWorker;
+
+        Bitboard attackMap[2][64];
+        Bitboard attackMapFull[2];
+        Bitboard attackCount[2][Attack::Worker::COUNT_PLANES];
+
+        memcpy(attackMap, worker.attackMap, sizeof(attackMap));
+        memcpy(attackMapFull, worker.attackMapFull, sizeof(attackMapFull));
+        memcpy(attackCount, worker.attackCount, sizeof(attackCount));
+
+        worker.generateAll(game);
+
+        bool match = memcmp(attackMap, worker.attackMap, sizeof(attackMap)) == 0 &&
+                     memcmp(attackMapFull, worker.attackMapFull, sizeof(attackMapFull)) == 0 &&
+                     memcmp(attackCount, worker.attackCount, sizeof(attackCount)) == 0;
+
+        memcpy(worker.attackMap, attackMap, sizeof(attackMap));
+        memcpy(worker.attackMapFull, attackMapFull, sizeof(attackMapFull));
+        memcpy(worker.attackCount, attackCount, sizeof(attackCount));
+
+        return match;
+    }
+
+    // Randomized playouts from the perft positions, every legal move is made and unmade
+    // and the incremental attack maps are compared against generateAll after each step
+    void attackTest(Rune::Game& game, int playouts)
+    {
+        constexpr int MAX_PLIES = 80;
+
+        std::mt19937 rng(1234);
+
+        long long checked = 0;
+        long long failures = 0;
+
+        std::clock_t start = std::clock();
+        printf("\n========== ATTACK TESTS START ==========\n");
+
+        for (int idx = 0; idx < PERFT_TEST_COUNT; ++idx)
+        {
+            long long failuresBefore = failures;
+
+            for (int playout = 0; playout < playouts; playout++)
+            {
+                Board::loadFen(game, tests[idx].fen);
+
+                int played = 0;
+
+                for (int ply = 0; ply < MAX_PLIES; ply++)
+                {
+                    Movegen::MoveList moves;
+                    game.movegenWorker.getLegalMoves(game, moves, false);
+
+                    if (moves.size() == 0) break;
+
+                    for (int i = 0; i < moves.size(); i++)
+                    {
+                        Board::makeMove(game, moves[i], MAKE_MOVE_LIGHT);
+                        bool afterMake = attacksMatch(game);
+
+                        Board::unmakeMove(game, MAKE_MOVE_LIGHT);
+                        bool afterUnmake = attacksMatch(game);
+
+                        checked++;
+
+                        if (!afterMake || !afterUnmake)
+                        {
+                            if (failures < 10)
+                                printf(" ❌ FAILED| %s | Move: %s | %s\n", Board::generateFen(game).c_str(),
+                                       Board::moveToString(moves[i]).c_str(), afterMake ? "unmake" : "make");
+
+                            failures++;
+                        }
+                    }
+
+                    Board::makeMove(game, moves[rng() % moves.size()], MAKE_MOVE_LIGHT);
+                    played++;
+                }
+
+                // Unwind so the history does not grow across playouts
+                while (played--) Board::unmakeMove(game, MAKE_MOVE_LIGHT);
+            }
+
+            if (failures == failuresBefore)
+                printf(" ✅ OK    | Test: %d | %s\n", idx + 1, tests[idx].fen);
+        }
+
+        double total_time_ms = (double)(std::clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+        printf("\n========== ATTACK TESTS END ==========\n");
+        printf("Moves checked: %lld | Failures: %lld\n", checked, failures);
+        printf("Total time: %.2f ms\n\n", total_time_ms);
+    }
+
+    void bench(Rune::Game& game)
+    {
+        long long totalNodes = 0;
+        double totalMs = 0.0;
+        int mismatches = 0;
+
+        printf("\n========== PERFT BENCH START ==========\n");
+
+        for (int idx = 0; idx < PERFT_TEST_COUNT; ++idx)
+        {
+            const PerftTest& test = tests[idx];
+
+            Board::loadFen(game, test.fen);
+
+            std::clock_t start = std::clock();
+            long long nodes = perft(game, test.end_depth);
+            double ms = (double)(std::clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+
+            // Speed only counts when the node count is still right
+            bool ok = nodes == test.expected_nodes[test.end_depth - 1];
+            if (!ok) mismatches++;
+
+            printf(" %s Test %d | Depth %d | Nodes %11lld | %9.2f ms | %6.2f Mnps\n", ok ? "✅" : "❌",
+                   idx + 1, test.end_depth, nodes, ms, ms > 0.0 ? nodes / ms / 1000.0 : 0.0);
+
+            totalNodes += nodes;
+            totalMs += ms;
+        }
+
+        printf("========== PERFT BENCH END ==========\n");
+        printf("Nodes: %lld | Time: %.2f ms | NPS: %.0f | Mismatches: %d\n\n", totalNodes, totalMs,
+               totalMs > 0.0 ? totalNodes * 1000.0 / totalMs : 0.0, mismatches);
+    }
+
+    // Random playouts from the perft positions, at every step each legal move is made and unmade
+    // repeatedly so the timing covers make/unmake alone, without move generation
+    void makeBench(Rune::Game& game, int repeats)
+    {
+        constexpr int MAX_PLIES = 80;
+
+        std::mt19937 rng(1234);
+
+        long long pairs = 0;
+        double totalMs = 0.0;
+
+        printf("\n========== MAKE BENCH START ==========\n");
+
+        for (int idx = 0; idx < PERFT_TEST_COUNT; ++idx)
+        {
+            Board::loadFen(game, tests[idx].fen);
+
+            long long pairsBefore = pairs;
+            double msBefore = totalMs;
+            int played = 0;
+
+            for (int ply = 0; ply < MAX_PLIES; ply++)
+            {
+                Movegen::MoveList moves;
+                game.movegenWorker.getLegalMoves(game, moves, false);
+
+                if (moves.size() == 0) break;
+
+                std::clock_t start = std::clock();
+
+                for (int r = 0; r < repeats; r++)
+                {
+                    for (int i = 0; i < moves.size(); i++)
+                    {
+                        Board::makeMove(game, moves[i], MAKE_MOVE_LIGHT);
+                        Board::unmakeMove(game, MAKE_MOVE_LIGHT);
+                    }
+                }
+
+                totalMs += (double)(std::clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+                pairs += (long long)repeats * moves.size();
+
+                Board::makeMove(game, moves[rng() % moves.size()], MAKE_MOVE_LIGHT);
+                played++;
+            }
+
+            // Unwind so the history does not grow across positions
+            while (played--) Board::unmakeMove(game, MAKE_MOVE_LIGHT);
+
+            long long n = pairs - pairsBefore;
+            double ms = totalMs - msBefore;
+            printf(" Test %d | Pairs %10lld | %9.2f ms | %6.2f ns/pair\n", idx + 1, n, ms, n > 0 ? ms * 1e6 / n : 0.0);
+        }
+
+        printf("========== MAKE BENCH END ==========\n");
+        printf("Pairs: %lld | Time: %.2f ms | %.2f ns per make/unmake\n\n", pairs, totalMs,
+               pairs > 0 ? totalMs * 1e6 / pairs : 0.0);
+    }
+
+    // Whether a move leaves the opponent in check, found the slow way with make/unmake
+    static bool checksAfterMake(Rune::Game& game, Move move)
+    {
+        int them = !game.turn;
+
+        Board::makeMove(game, move, MAKE_MOVE_LIGHT);
+        bool check = Board::isKingInCheck(game, them);
+        Board::unmakeMove(game, MAKE_MOVE_LIGHT);
+
+        return check;
+    }
+
+    static bool contains(const Movegen::MoveList& moves, Move move)
+    {
+        for (int i = 0; i < moves.size(); i++)
+            if (moves[i] == move) return true;
+
+        return false;
+    }
+
+    // Randomized playouts from the perft positions, at every step givesCheck must agree with makeMove
+    // for each legal move, generate<QUIET_CHECKS> must produce exactly the quiet ones that check
+    // and getLegalChecks exactly the ones that check
+    void checkTest(Rune::Game& game, int playouts)
+    {
+        constexpr int MAX_PLIES = 80;
+
+        std::mt19937 rng(1234);
+
+        long long checked = 0;
+        long long failures = 0;
+
+        auto fail = [&](Move move, const char* what) {
+            if (failures < 10)
+                printf(" ❌ FAILED| %s | Move: %s | %s\n", Board::generateFen(game).c_str(), Board::moveToString(move).c_str(), what);
+
+            failures++;
+        };
+
+        std::clock_t start = std::clock();
+        printf("\n========== CHECK TESTS START ==========\n");
+
+        for (int idx = 0; idx < PERFT_TEST_COUNT; ++idx)
+        {
+            long long failuresBefore = failures;
+
+            for (int playout = 0; playout < playouts; playout++)
+            {
+                Board::loadFen(game, tests[idx].fen);
+
+                int played = 0;
+
+                for (int ply = 0; ply < MAX_PLIES; ply++)
+                {
+                    Movegen::MoveList moves;
+                    game.movegenWorker.getLegalMoves(game, moves, false);
+
+                    if (moves.size() == 0) break;
+
+                    Movegen::CheckInfo checkInfo;
+                    game.movegenWorker.getCheckInfo(game, checkInfo);
+
+                    Movegen::MoveList quietChecks;
+                    game.movegenWorker.generate<Movegen::QUIET_CHECKS>(game, quietChecks);
+
+                    Movegen::MoveList legalChecks;
+                    game.movegenWorker.getLegalChecks(game, legalChecks);
+
+                    int checkCount = 0;
+
+                    for (int i = 0; i < quietChecks.size(); i++)
+                    {
+                        Move move = quietChecks[i];
+
+                        if (Helpers::is_capture(move) || Helpers::is_promo(move) || Helpers::is_castle(move))
+                            fail(move, "quiet check generator produced a capture, promotion or castle");
+                    }
+
+                    for (int i = 0; i < moves.size(); i++)
+                    {
+                        Move move = moves[i];
+                        bool checks = checksAfterMake(game, move);
+
+                        checked++;
+
+                        if (game.movegenWorker.givesCheck(game, move, checkInfo) != checks)
+                            fail(move, checks ? "givesCheck missed a check" : "givesCheck reported a check that is not there");
+
+                        bool quiet = !Helpers::is_capture(move) && !Helpers::is_promo(move) && !Helpers::is_castle(move);
+
+                        if (quiet && checks != contains(quietChecks, move))
+                            fail(move, checks ? "quiet check missing from generator" : "generator produced a non-checking move");
+
+                        if (checks != contains(legalChecks, move))
+                            fail(move, checks ? "check missing from getLegalChecks" : "getLegalChecks produced a non-checking move");
+
+                        if (checks) checkCount++;
+                    }
+
+                    // Every listed check was matched above, so only illegal extras can be left over
+                    if (legalChecks.size() > checkCount)
+                        fail(0, "getLegalChecks produced an illegal move");
+
+                    Board::makeMove(game, moves[rng() % moves.size()], MAKE_MOVE_LIGHT);
+                    played++;
+                }
+
+                // Unwind so the history does not grow across playouts
+                while (played--) Board::unmakeMove(game, MAKE_MOVE_LIGHT);
+            }
+
+            if (failures == failuresBefore)
+                printf(" ✅ OK    | Test: %d | %s\n", idx + 1, tests[idx].fen);
+        }
+
+        double total_time_ms = (double)(std::clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+        printf("\n========== CHECK TESTS END ==========\n");
+        printf("Moves checked: %lld | Failures: %lld\n", checked, failures);
+        printf("Total time: %.2f ms\n\n", total_time_ms);
+    }
+
+    // Roots the search must answer without touching an empty or short root move list
+    struct SearchTest {
+        const char* fen;
+        const char* name;
+    };
+
+    const SearchTest searchTests[] = {
+        { "7k/6Q1/6K1/8/8/8/8/8 b - - 0 1",                                       "checkmated root" },
+        { "7k/5Q2/6K1/8/8/8/8/8 b - - 0 1",                                       "stalemated root" },
+        { "7k/8/6K1/8/8/8/8/5Q2 b - - 0 1",                                       "single legal move" },
+        { "k7/8/8/8/8/8/8/K7 b - - 0 1",                                          "fewer moves than MultiPV" },
+        { "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq -",     "middlegame" }
+    };
+
+    // Every search entry point on each root, with one and several PV slots, must return
+    // a legal move, or no move exactly when the side to move has none
+    void searchTest(Rune::Game& game)
+    {
+        constexpr int MULTI_PV[2] = { 1, 5 };
+
+        int failures = 0;
+
+        bool doInfo = game.config.search.doInfo;
+        int multiPV = game.config.search.multiPV;
+
+        game.config.search.doInfo = false;
+
+        std::clock_t start = std::clock();
+        printf("\n========== SEARCH TESTS START ==========\n");
+
+        for (const SearchTest& test : searchTests)
+        {
+            int failuresBefore = failures;
+
+            for (int pv : MULTI_PV)
+            {
+                game.config.search.multiPV = pv;
+
+                for (int mode = 0; mode < 2; mode++)
+                {
+                    Board::loadFen(game, test.fen);
+                    game.transpositionTable.clear();
+
+                    Movegen::MoveList moves;
+                    game.movegenWorker.getLegalMoves(game, moves, false);
+
+                    Move best = (mode == 0) ? game.searchWorker.searchPosition(game, 3, game.searchWorker.maximumSearchTime)
+                                            : game.searchWorker.searchMate(game, 2, game.searchWorker.maximumSearchTime);
+
+                    bool ok = (moves.size() == 0) ? best == 0 : contains(moves, best);
+
+                    if (!ok)
+                    {
+                        printf(" ❌ FAILED| %s | %s | MultiPV %d | %s returned %s\n", test.name, test.fen, pv,
+                               mode == 0 ? "go depth 3" : "go mate 2", best == 0 ? "(none)" : Board::moveToString(best).c_str());
+                        failures++;
+                    }
+                }
+            }
+
+            if (failures == failuresBefore)
+                printf(" ✅ OK    | %s | %s\n", test.name, test.fen);
+        }
+
+        game.config.search.doInfo = doInfo;
+        game.config.search.multiPV = multiPV;
+
+        double total_time_ms = (double)(std::clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+        printf("\n========== SEARCH TESTS END ==========\n");
+        printf("Failures: %d\n", failures);
+        printf("Total time: %.2f ms\n\n", total_time_ms);
+    }
+
+    // Run one slider lookup function over the sample set, returns elapsed milliseconds
+    template <typename Lookup>
+    static double timeLookups(Lookup lookup, const int* squares, const Bitboard* occupancies, int samples, int lookups, Bitboard& checksum)
+    {
+        std::clock_t start = std::clock();
+
+        for (int i = 0; i < lookups; i++)
+        {
+            int s = i & (samples - 1);
+            checksum ^= lookup(squares[s], occupancies[s] ^ checksum);
+        }
+
+        return (double)(std::clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+    }
+
+    void magicBench(int lookups)
+    {
+        constexpr int SAMPLES = 4096;
+
+        int squares[SAMPLES];
+        Bitboard occupancies[SAMPLES];
+
+        // Sparse random boards, roughly the density of a middlegame
+        std::mt19937_64 rng(4321);
+        for (int i = 0; i < SAMPLES; i++)
+        {
+            squares[i] = rng() & 63;
+            occupancies[i] = rng() & rng();
+        }
+
+        printf("\n========== MAGIC BENCH START ==========\n");
+        printf("CPU has fast PEXT: %s | Selected backend: %s\n", Magic::hasFastPext() ? "yes" : "no", Magic::usePext ? "pext" : "magic");
+
+        auto report = [lookups](const char* name, double ms) {
+            printf(" %-14s | %8.2f ms | %6.2f ns/lookup\n", name, ms, ms * 1e6 / lookups);
+        };
+
+        Bitboard checksum = 0ULL;
+        bool selected = Magic::usePext;
+
+        // One packed table per piece, so each backend is timed with the tables rebuilt in its own order
+        Magic::build(false);
+        report("magic bishop", timeLookups(Magic::getBishopAttacksMagic, squares, occupancies, SAMPLES, lookups, checksum));
+        report("magic rook",   timeLookups(Magic::getRookAttacksMagic,   squares, occupancies, SAMPLES, lookups, checksum));
+
+#if defined(__BMI2__)
+        static Bitboard expected[SAMPLES][2];
+        for (int i = 0; i < SAMPLES; i++)
+        {
+            expected[i][0] = Magic::getBishopAttacksMagic(squares[i], occupancies[i]);
+            expected[i][1] = Magic::getRookAttacksMagic(squares[i], occupancies[i]);
+        }
+
+        Magic::build(true);
+        report("pext bishop",  timeLookups(Magic::getBishopAttacksPext,  squares, occupancies, SAMPLES, lookups, checksum));
+        report("pext rook",    timeLookups(Magic::getRookAttacksPext,    squares, occupancies, SAMPLES, lookups, checksum));
+
+        int mismatches = 0;
+        for (int i = 0; i < SAMPLES; i++)
+        {
+            if (Magic::getBishopAttacksPext(squares[i], occupancies[i]) != expected[i][0]) mismatches++;
+            if (Magic::getRookAttacksPext(squares[i], occupancies[i])   != expected[i][1]) mismatches++;
+        }
+        printf("Backend mismatches: %d\n", mismatches);
+#else
+        printf(" pext           | not compiled in, build with BMI2 enabled (-mbmi2 or -march=native)\n");
+#endif
+
+        Magic::build(selected);
+
+        printf("========== MAGIC BENCH END ==========\n");
+        printf("Checksum: %llx\n\n", (unsigned long long)checksum);
+    }
+
+} // namespace Perft
@@ -2,17 +2,182 @@
 #include <core/search.hpp>
 #include <core/eval.hpp>
 #include <tables/zobrist.hpp>
+#include <tables/magic.hpp>
 #include <cstdlib>
 #include <cstdio>
 
 namespace Rune {
+    // Castling rights kept when a move leaves or lands on a square
+    static constexpr CastlingRights castlingMask[64] = {
+        0xD, 0xF, 0xF, 0xF, 0xC, 0xF, 0xF, 0xE,
+        0xF, 0xF, 0xF, 0xF, 0xF, 0xF, 0xF, 0xF,
+        0xF, 0xF, 0xF, 0xF, 0xF, 0xF, 0xF, 0xF,
+        0xF, 0xF, 0xF, 0xF, 0xF, 0xF, 0xF, 0xF,
+        0xF, 0xF, 0xF, 0xF, 0xF, 0xF, 0xF, 0xF,
+        0xF, 0xF, 0xF, 0xF, 0xF, 0xF, 0xF, 0xF,
+        0xF, 0xF, 0xF, 0xF, 0xF, 0xF, 0xF, 0xF,
+        0x7, 0xF, 0xF, 0xF, 0x3, 0xF, 0xF, 0xB
+    };
+
+    Piece Position::makeMove(Move move)
+    {
+        const int from = Helpers::get_from(move);
+        const int to   = Helpers::get_to(move);
+
+        const Piece piece = boardGhost[from];
+        const int color   = Helpers::get_color(piece);
+
+        Piece captured = EMPTY;
+
+        // Side to move always flips
+        ZobristHash key = zobristKey ^ Zobrist::turnKey();
+
+        // Any en passant square expires, a double push sets a new one
+        if (enpassantSquare != -1) {
+            key ^= Zobrist::enpassantKey(enpassantSquare & 7);
+            enpassantSquare = -1;
+        }
+
+        // Each kind touches only the squares it needs
+        switch (Helpers::get_kind(move)) {
+            case MOVE_QUIET:
+                movePiece(piece, from, to);
+                key ^= Zobrist::pieceKey(piece, from) ^ Zobrist::pieceKey(piece, to);
+                break;
+
+            case MOVE_DOUBLE_PUSH:
+                movePiece(piece, from, to);
+                key ^= Zobrist::pieceKey(piece, from) ^ Zobrist::pieceKey(piece, to);
+
+                enpassantSquare = (from + to) / 2;
+                key ^= Zobrist::enpassantKey(enpassantSquare & 7);
+                break;
+
+            case MOVE_CASTLE: {
+                const int rookFrom = PrecomputedTables::castlingRooks.from[to];
+                const int rookTo   = PrecomputedTables::castlingRooks.to[to];
+                const Piece rook   = boardGhost[rookFrom];
+
+                movePiece(piece, from, to);
+                movePiece(rook, rookFrom, rookTo);
+                key ^= Zobrist::pieceKey(piece, from) ^ Zobrist::pieceKey(piece, to) ^
+                       Zobrist::pieceKey(rook, rookFrom) ^ Zobrist::pieceKey(rook, rookTo);
+
+                hasCastled[color] = true;
+                break;
+            }
+
+            case MOVE_CAPTURE:
+                captured = boardGhost[to];
+
+                removePiece(captured, to);
+                movePiece(piece, from, to);
+                key ^= Zobrist::pieceKey(captured, to) ^ Zobrist::pieceKey(piece, from) ^ Zobrist::pieceKey(piece, to);
+                break;
+
+            case MOVE_ENPASSANT: {
+                const int captureSq = (color == WHITE) ? to - 8 : to + 8;
+                captured = boardGhost[captureSq];
+
+                removePiece(captured, captureSq);
+                movePiece(piece, from, to);
+                key ^= Zobrist::pieceKey(captured, captureSq) ^ Zobrist::pieceKey(piece, from) ^ Zobrist::pieceKey(piece, to);
+                break;
+            }
+
+            default: {
+                // Promotions, with or without a capture
+                const Piece promoted = Helpers::make_piece(Helpers::get_promo(move), color);
+
+                if (Helpers::is_capture(move)) {
+                    captured = boardGhost[to];
+
+                    removePiece(captured, to);
+                    key ^= Zobrist::pieceKey(captured, to);
+                }
+
+                removePiece(piece, from);
+                addPiece(promoted, to);
+                key ^= Zobrist::pieceKey(piece, from) ^ Zobrist::pieceKey(promoted, to);
+                break;
+            }
+        }
+
+        // Castling rights, the key only changes when a king or rook home square is involved
+        const CastlingRights rights = castlingRights & castlingMask[from] & castlingMask[to];
+        if (rights != castlingRights) {
+            key ^= Zobrist::castlingKey(castlingRights) ^ Zobrist::castlingKey(rights);
+            castlingRights = rights;
+        }
+
+        turn ^= 1;
+        ply++;
+
+        // Pawn moves and captures are irreversible
+        if (Helpers::get_type(piece) == PAWN || captured != EMPTY) fiftyMoveCounter = 0;
+        else fiftyMoveCounter++;
+
+        zobristKey = key;
+
+        return captured;
+    }
+
+    void Position::unmakeMove(Move move, Piece captured)
+    {
+        const int from = Helpers::get_from(move);
+        const int to   = Helpers::get_to(move);
+
+        const Piece piece = boardGhost[to];
+        const int color   = Helpers::get_color(piece);
+
+        switch (Helpers::get_kind(move)) {
+            case MOVE_QUIET:
+            case MOVE_DOUBLE_PUSH:
+                movePiece(piece, to, from);
+                break;
+
+            case MOVE_CASTLE: {
+                const int rookFrom = PrecomputedTables::castlingRooks.from[to];
+                const int rookTo   = PrecomputedTables::castlingRooks.to[to];
+
+                movePiece(piece, to, from);
+                movePiece(boardGhost[rookTo], rookTo, rookFrom);
+
+                hasCastled[color] = false;
+                break;
+            }
+
+            case MOVE_CAPTURE:
+                movePiece(piece, to, from);
+                addPiece(captured, to);
+                break;
+
+            case MOVE_ENPASSANT:
+                movePiece(piece, to, from);
+                addPiece(captured, (color == WHITE) ? to - 8 : to + 8);
+                break;
+
+            default:
+                // Promotions: the promoted piece leaves, the pawn comes back
+                removePiece(piece, to);
+                addPiece(Helpers::make_piece(PAWN, color), from);
+
+                if (captured != EMPTY) addPiece(captured, to);
+                break;
+        }
+    }
+
+    void Position::makeNullMove()
+    {
+        if (enpassantSquare != -1) zobristKey ^= Zobrist::enpassantKey(enpassantSquare & 7);
+        enpassantSquare = -1;
+
+        turn ^= 1;
+        zobristKey ^= Zobrist::turnKey();
+    }
+
     Game::Game()
-    : board{}, occupancy{}, boardGhost{},
-      turn(WHITE),
-      enpassantSquare(-1),
-      castlingRights(CASTLING_ALL),
-      ply(0),
-      hasCastled{false, false},
+    : Position(),
       movelist(),
       transpositionTable(),
       repetitionTable(),
@@ -23,23 +188,21 @@ namespace Rune {
       config(),              // default construct nested config
       historyCount(0),
       isFirstLoad(1),
-      history(std::make_unique<State[]>(HISTORY_SIZE)),
+      history(HISTORY_GAME_PLIES + HISTORY_SEARCH_PLIES),
       outOfOpeningBook(false),
-      zobristKey(0ULL),
       pvLine()
     {
-        // Initialize attack worker precomputed tables
-        attackWorker.preComputed.preComputeAll();
+        // Slider lookup tables and backend, built once per process
+        Magic::init();
 
         // Ensure attack maps are cleared
         for (int c = 0; c < 2; ++c) {
             attackWorker.attackMapFull[c] = 0ULL;
             for (int s = 0; s < 64; ++s)
                 attackWorker.attackMap[c][s] = 0ULL;
+            for (int i = 0; i < Attack::Worker::COUNT_PLANES; ++i)
+                attackWorker.attackCount[c][i] = 0ULL;
         }
-
-        // Initialize zobrist hasher
-        Zobrist::init();
     }
 
     Game::~Game() {
@@ -32,6 +32,10 @@ namespace Search {
 
         if (elapsedMs >= (thinkTime - SEARCH_THINK_TIME_MARGIN))
             searchCancelled = true;
+
+        // Node budget is independent of machine speed, so limited searches are reproducible
+        if (nodeLimit > 0 && nodes >= nodeLimit)
+            searchCancelled = true;
     }
 
     double Worker::getTimer()
@@ -61,33 +65,11 @@ namespace Search {
         Piece tPiece = game.boardGhost[to];
 
         int fType = Helpers::get_type(fPiece);
-        int tType = Helpers::get_type(tPiece);
-
-        return mvvLvaScores[fType - 1][tType - 1];
-    }
-
-    bool Worker::predictCheck(Rune::Game& game, Move move)
-    {
-        int enemyKingSquare = Board::findKing(game, !game.turn);
-
-        Bitboard newAttacks = game.attackWorker.getNewAttacksForMove(game, move);
-
-        if ((newAttacks & (1ULL << enemyKingSquare)) != 0) return true;
+        int tType = Helpers::is_enpassant(move) ? PAWN : Helpers::get_type(tPiece);
 
-        return false;
-    }
-
-    bool Worker::predictRecapture(Rune::Game& game, Move move)
-    {
-        int to = Helpers::get_to(move);
-
-        Bitboard enemyAttacks = game.attackWorker.attackMapFull[!game.turn];
+        if (tType == EMPTY) return 0;
 
-        if (enemyAttacks & (1ULL << to))
-            // Opponent can recapture
-            return true;
-        
-        return false;
+        return mvvLvaScores[tType - 1][fType - 1];
     }
 
     bool Worker::isNullMovePruneSafe(Rune::Game& game, Movegen::MoveList& movelist)
@@ -138,67 +120,162 @@ namespace Search {
         }
     }
 
-    int Worker::evaluateStaticExchange(Rune::Game& game, int to)
+    int Worker::getLeastValuableAttacker(Rune::Game& game, Bitboard attackers, int color, int& type)
     {
-        int gain[16]; // usually enough
-        Piece captured = game.boardGhost[to];
-        if (captured == EMPTY) return 0;
+        // Piece bitboards in value order, so the first hit is the cheapest attacker
+        for (type = PAWN; type <= KING; type++)
+        {
+            Bitboard options = attackers & game.board[color][type];
 
-        gain[0] = game.evalWorker.pieceValues[Helpers::get_type(captured)];
+            if (options) return __builtin_ctzll(options);
+        }
 
+        type = EMPTY;
+        return -1;
+    }
+
+    int Worker::staticExchange(Rune::Game& game, Move move)
+    {
+        if (Helpers::is_castle(move)) return 0;
+
+        int from = Helpers::get_from(move);
+        int to   = Helpers::get_to(move);
+
+        int gain[32];
+        int depth = 0;
+
+        int attackerType = Helpers::get_type(game.boardGhost[from]);
         Bitboard occupancy = game.occupancy[BOTH];
-        Bitboard colorAttackers[2];
-        colorAttackers[WHITE] = game.attackWorker.getAttackersForSquare(game, WHITE, to);
-        colorAttackers[BLACK] = game.attackWorker.getAttackersForSquare(game, BLACK, to);
 
-        int numCaptures = 0;
-        int side = game.turn;
+        if (Helpers::is_enpassant(move))
+        {
+            gain[0] = seeValues[PAWN];
+            occupancy ^= 1ULL << ((game.turn == WHITE) ? to - 8 : to + 8);
+        }
+        else
+        {
+            gain[0] = seeValues[Helpers::get_type(game.boardGhost[to])];
+        }
 
-        while (colorAttackers[side])
+        if (Helpers::is_promo(move))
         {
-            int from = getLeastValuablePiece(game, colorAttackers[side]);
-            Piece piece = game.boardGhost[from];
-            numCaptures++;
+            attackerType = Helpers::get_promo(move);
+            gain[0] += seeValues[attackerType] - seeValues[PAWN];
+        }
 
-            gain[numCaptures] = game.evalWorker.pieceValues[Helpers::get_type(piece)] - gain[numCaptures - 1];
+        const Bitboard diagonal   = game.board[WHITE][BISHOP] | game.board[WHITE][QUEEN] | game.board[BLACK][BISHOP] | game.board[BLACK][QUEEN];
+        const Bitboard orthogonal = game.board[WHITE][ROOK]   | game.board[WHITE][QUEEN] | game.board[BLACK][ROOK]   | game.board[BLACK][QUEEN];
 
-            if (std::max(-gain[numCaptures - 1], gain[numCaptures]) < 0)
-                break;
+        occupancy ^= 1ULL << from;
+
+        Bitboard attackers = game.attackWorker.attackersTo(game, to, occupancy) & occupancy;
 
-            occupancy ^= (1ULL << from);
-            colorAttackers[side] &= ~(1ULL << from); // remove this attacker
+        int side = !game.turn;
+
+        while (true)
+        {
+            depth++;
+
+            // Score if the piece now standing on the square is taken
+            gain[depth] = seeValues[attackerType] - gain[depth - 1];
+
+            int type;
+            int square = getLeastValuableAttacker(game, attackers & game.occupancy[side], side, type);
+
+            if (square < 0) break;
+
+            // The king may only capture when nothing defends the square
+            if (type == KING && (attackers & game.occupancy[!side] & ~(1ULL << square))) break;
+
+            occupancy ^= 1ULL << square;
+
+            // Sliders behind the capturer join in
+            if (type == PAWN || type == BISHOP || type == QUEEN)
+                attackers |= Magic::getBishopAttacks(to, occupancy) & diagonal;
+            if (type == ROOK || type == QUEEN)
+                attackers |= Magic::getRookAttacks(to, occupancy) & orthogonal;
+
+            attackers &= occupancy;
+
+            attackerType = type;
             side ^= 1;
+
+            if (depth >= 31) break;
         }
 
-        int bestGain = gain[0];
-        for (int i = 1; i <= numCaptures; i++)
-            bestGain = std::max(-gain[i], bestGain);
+        // The last entry is speculative, fold the rest back from the end
+        while (--depth)
+            gain[depth - 1] = -std::max(-gain[depth - 1], gain[depth]);
 
-        return bestGain;
+        return gain[0];
     }
 
-    int Worker::getLeastValuablePiece(Rune::Game& game, Bitboard options)
+    bool Worker::seeGE(Rune::Game& game, Move move, int threshold)
     {
-        int bestOption = -1;
-        int bestValue = INF;
+        if (Helpers::is_castle(move)) return 0 >= threshold;
+
+        int from = Helpers::get_from(move);
+        int to   = Helpers::get_to(move);
 
-        while (options)
+        int capturedValue = Helpers::is_enpassant(move) ? seeValues[PAWN] : seeValues[Helpers::get_type(game.boardGhost[to])];
+        int moverValue    = seeValues[Helpers::get_type(game.boardGhost[from])];
+
+        if (Helpers::is_promo(move))
         {
-            int square = Helpers::pop_lsb(options);
+            capturedValue += seeValues[Helpers::get_promo(move)] - seeValues[PAWN];
+            moverValue = seeValues[Helpers::get_promo(move)];
+        }
 
-            Piece piece = game.boardGhost[square];
+        // Even winning the target outright does not reach the threshold
+        int swap = capturedValue - threshold;
+        if (swap < 0) return false;
 
-            int type = Helpers::get_type(piece);
-            int value = game.evalWorker.pieceValues[type];
+        // Even losing the mover right back still reaches it
+        swap = moverValue - swap;
+        if (swap <= 0) return true;
 
-            if (value < bestValue)
-            {
-                bestValue = value;
-                bestOption = square;
-            }
+        Bitboard occupancy = game.occupancy[BOTH] ^ (1ULL << from);
+
+        if (Helpers::is_enpassant(move))
+            occupancy ^= 1ULL << ((game.turn == WHITE) ? to - 8 : to + 8);
+
+        const Bitboard diagonal   = game.board[WHITE][BISHOP] | game.board[WHITE][QUEEN] | game.board[BLACK][BISHOP] | game.board[BLACK][QUEEN];
+        const Bitboard orthogonal = game.board[WHITE][ROOK]   | game.board[WHITE][QUEEN] | game.board[BLACK][ROOK]   | game.board[BLACK][QUEEN];
+
+        Bitboard attackers = game.attackWorker.attackersTo(game, to, occupancy) & occupancy;
+
+        int side = game.turn;
+        int result = 1;
+
+        while (true)
+        {
+            side ^= 1;
+            attackers &= occupancy;
+
+            Bitboard sideAttackers = attackers & game.occupancy[side];
+            if (!sideAttackers) break;
+
+            result ^= 1;
+
+            int type;
+            int square = getLeastValuableAttacker(game, sideAttackers, side, type);
+
+            // Capturing with the king only works when the other side has nothing left
+            if (type == KING)
+                return (attackers & game.occupancy[!side]) ? !result : result;
+
+            swap = seeValues[type] - swap;
+            if (swap < result) break;
+
+            occupancy ^= 1ULL << square;
+
+            if (type == PAWN || type == BISHOP || type == QUEEN)
+                attackers |= Magic::getBishopAttacks(to, occupancy) & diagonal;
+            if (type == ROOK || type == QUEEN)
+                attackers |= Magic::getRookAttacks(to, occupancy) & orthogonal;
         }
 
-        return bestOption;
+        return result;
     }
 
     void Worker::orderMoves(Rune::Game& game, Movegen::MoveList& movelist)
@@ -211,6 +288,9 @@ namespace Search {
         std::vector<MoveScore> scored;
         scored.reserve(movelist.size());
 
+        Movegen::CheckInfo checkInfo;
+        game.movegenWorker.getCheckInfo(game, checkInfo);
+
         for (int i = 0; i < movelist.size(); i++)
         {
             Move m = movelist[i];
@@ -231,14 +311,14 @@ namespace Search {
             if (Helpers::is_capture(m))
             {
                 // Static Exchange Evaluation: expected material gain
-                int seeValue = evaluateStaticExchange(game, to);
+                int seeValue = staticExchange(game, m);
                 score += SEARCH_MOVE_CAPTURE + seeValue;
 
                 // MVV-LVA tie-breaker (optional small fraction)
                 score += getMvvLvaScore(game, m) / 10;
 
                 // Good / bad capture bias
-                if (!predictRecapture(game, m))
+                if (seeValue >= 0)
                     score += SEARCH_MOVE_CAPTURE_BIAS;  // good capture
                 else
                     score -= SEARCH_MOVE_CAPTURE_BIAS;  // bad capture
@@ -247,7 +327,7 @@ namespace Search {
             // ----------------------------
             // 3. Check bonus
             // ----------------------------
-            if (predictCheck(game, m))
+            if (game.movegenWorker.givesCheck(game, m, checkInfo))
                 score += SEARCH_MOVE_CHECK;
 
             // ----------------------------
@@ -287,11 +367,78 @@ namespace Search {
         orderMoves(game, movelist);
     }
 
+    void Worker::initRootMoves(Rune::Game& game, const std::vector<Move>& searchMoves)
+    {
+        Movegen::MoveList movelist;
+
+        // Probe TT for a PV move so the first iteration starts from a sensible order
+        Move tmpBestMove = 0;
+        int tmpScore = 0;
+
+        if (game.config.search.doTranspositions)
+            game.transpositionTable.probe(game.zobristKey, 0, -INF, INF, 0, tmpScore, tmpBestMove);
+
+        this->ttMove = tmpBestMove;
+
+        requestMoves(game, movelist, NEGAMAX);
+
+        rootMoves.clear();
+
+        for (int i = 0; i < movelist.size(); i++)
+        {
+            Move move = movelist[i];
+
+            // go searchmoves restricts the root to the listed moves
+            if (!searchMoves.empty())
+            {
+                auto listed = std::find_if(searchMoves.begin(), searchMoves.end(), [move](Move m) {
+                    return Helpers::get_from(m) == Helpers::get_from(move)
+                        && Helpers::get_to(m) == Helpers::get_to(move)
+                        && Helpers::get_promo(m) == Helpers::get_promo(move);
+                });
+
+                if (listed == searchMoves.end()) continue;
+            }
+
+            rootMoves.push_back({ move, -INF, 0, {} });
+        }
+
+        // None of the listed moves are legal here, say so rather than quietly answering a different question
+        if (rootMoves.empty() && !searchMoves.empty())
+        {
+            UCI::debug(__FILE__, "none of the %d searchmoves are legal, ignoring the restriction and searching all moves", (int) searchMoves.size());
+            initRootMoves(game, {});
+        }
+    }
+
+    void Worker::sortRootMoves(Move bestMove)
+    {
+        if (rootMoves.empty()) return;
+
+        // Best move of the previous iteration first
+        auto best = std::find_if(rootMoves.begin(), rootMoves.end(), [bestMove](const RootMove &rm) {
+            return rm.move == bestMove;
+        });
+
+        if (best != rootMoves.end())
+            std::rotate(rootMoves.begin(), best, best + 1);
+
+        // The rest by subtree size: moves that were hard to refute are the likeliest to become best
+        std::stable_sort(rootMoves.begin() + 1, rootMoves.end(), [](const RootMove &a, const RootMove &b) {
+            return a.nodes > b.nodes;
+        });
+    }
+
     // -------------------------
     // Quiescence search
     // -------------------------
     int Worker::quiescense(Rune::Game& game, int depth, int alpha, int beta, int ply, std::vector<Move>& pv)
     {
+        nodes++;
+        qnodes++;
+
+        if (ply > selDepth) selDepth = ply;
+
         if (depth >= game.config.search.maximumQuiescenseDepth)
             return game.evalWorker.evaluate(game);
 
@@ -318,6 +465,9 @@ namespace Search {
 
             Move move = movelist[i];
 
+            // Captures that lose material cannot raise alpha over the stand pat
+            if (game.config.search.doSeePruning && !seeGE(game, move, 0)) continue;
+
             Board::makeMove(game, move, MAKE_MOVE_LIGHT);
             std::vector<Move> childPV;
 
@@ -358,6 +508,21 @@ namespace Search {
     // -------------------------
     int Worker::negamax(Rune::Game& game, int depth, int alpha, int beta, int ply, std::vector<Move>& pv)
     {
+        nodes++;
+
+        if (ply > selDepth) selDepth = ply;
+
+        // Repetition draw, checked before the TT since stored scores do not know the path
+        if (game.repetitionTable.isRepetition(game.fiftyMoveCounter, ply))
+            return DRAW_SCORE;
+
+        // A move back into an earlier position is available, so this node is worth at least a draw
+        if (alpha < DRAW_SCORE && game.repetitionTable.hasUpcomingRepetition(game.occupancy[BOTH], game.fiftyMoveCounter, ply))
+        {
+            alpha = DRAW_SCORE;
+            if (alpha >= beta) return alpha;
+        }
+
         if (depth == 0)
         {
             int score = (game.config.search.doQuiescense) ? quiescense(game, 0, alpha, beta, ply + 1, pv) : game.evalWorker.evaluate(game);
@@ -379,6 +544,11 @@ namespace Search {
             return ttScore;
         }
 
+        // Internal iterative reduction: without a TT move our ordering is a guess,
+        // so search this node one ply shallower and let the next iteration fill the TT
+        if (game.config.search.doTranspositions && ttMove == 0 && depth >= INTERNAL_ITERATIVE_REDUCTION_DEPTH)
+            depth--;
+
         // Store TT move so requestMoves can reorder
         this->ttMove = ttMove;
 
@@ -410,12 +580,17 @@ namespace Search {
 
         std::vector<Move> bestChildPV;
 
+        Movegen::CheckInfo checkInfo;
+        game.movegenWorker.getCheckInfo(game, checkInfo);
+
         for (int i = 0; i < movelist.size(); i++)
         {
             checkTimer();
             if (searchCancelled) break;
 
             Move move = movelist[i];
+            bool givesCheck = game.movegenWorker.givesCheck(game, move, checkInfo);
+
             Board::makeMove(game, move, MAKE_MOVE_FULL);
             
             std::vector<Move> childPV;
@@ -423,40 +598,33 @@ namespace Search {
             int eval = 0;
             int newDepth = depth - 1;
 
-            if (game.repetitionTable.checkThreefold(game.zobristKey))
+            if (i == 0)
             {
-                eval = DRAW_SCORE;
+                // First move: full-window search
+                eval = -negamax(game, newDepth, -beta, -alpha, ply + 1, childPV);
             }
             else
             {
-                if (i == 0)
-                {
-                    // First move: full-window search
-                    eval = -negamax(game, newDepth, -beta, -alpha, ply + 1, childPV);
-                }
-                else
-                {
-                    bool isQuietMove = !Helpers::is_capture(move) &&
-                                    !Helpers::is_promo(move) &&
-                                    !predictCheck(game, move);
+                bool isQuietMove = !Helpers::is_capture(move) &&
+                                !Helpers::is_promo(move) &&
+                                !givesCheck;
 
-                    int reduction = 0;
+                int reduction = 0;
 
-                    if (depth >= 3 && i >= 4 && isQuietMove)
-                    {
-                        reduction = 1;
-                        if (depth >= 5 && i >= 10) reduction++;
-                        if (depth >= 7 && i >= 15) reduction++;
-                    }
+                if (depth >= 3 && i >= 4 && isQuietMove)
+                {
+                    reduction = 1;
+                    if (depth >= 5 && i >= 10) reduction++;
+                    if (depth >= 7 && i >= 15) reduction++;
+                }
 
-                    // First try reduced depth null-window search (LMR + PVS combined)
-                    eval = -negamax(game, newDepth - reduction, -alpha - 1, -alpha, ply + 1, childPV);
+                // First try reduced depth null-window search (LMR + PVS combined)
+                eval = -negamax(game, newDepth - reduction, -alpha - 1, -alpha, ply + 1, childPV);
 
-                    // Re-search if needed
-                    if ((reduction > 0 && eval > alpha) || (eval > alpha && eval < beta))
-                    {
-                        eval = -negamax(game, newDepth, -beta, -alpha, ply + 1, childPV);
-                    }
+                // Re-search if needed
+                if ((reduction > 0 && eval > alpha) || (eval > alpha && eval < beta))
+                {
+                    eval = -negamax(game, newDepth, -beta, -alpha, ply + 1, childPV);
                 }
             }
 
@@ -505,33 +673,186 @@ namespace Search {
     }
 
     // -------------------------
-    // Entry point
+    // Mate search
     // -------------------------
-    Move Worker::searchPosition(Rune::Game& game, int initialDepth, int thinkTimeMs)
+    int Worker::mateSearch(Rune::Game& game, int depth, int alpha, int beta, int ply, std::vector<Move>& pv)
+    {
+        nodes++;
+
+        if (ply > selDepth) selDepth = ply;
+
+        pv.clear();
+
+        // Mate distance pruning: nothing here can beat a mate already found closer to the root
+        alpha = std::max(alpha, -MATE_SCORE + ply);
+        beta  = std::min(beta, MATE_SCORE - ply - 1);
+
+        if (alpha >= beta) return alpha;
+
+        // The root side is the attacker and may only check, the defender gets every evasion
+        bool isAttacker = (ply % 2) == 0;
+
+        Movegen::MoveList movelist;
+
+        if (isAttacker)
+            game.movegenWorker.getLegalChecks(game, movelist);
+        else
+            game.movegenWorker.getLegalMoves(game, movelist, false);
+
+        if (movelist.size() == 0)
+        {
+            bool inCheck = Board::isKingInCheck(game, game.turn);
+
+            // An attacker without checks is only mated when it is in check and has no evasion either
+            if (isAttacker && inCheck)
+                game.movegenWorker.getLegalMoves(game, movelist, false);
+
+            if (movelist.size() == 0)
+                return inCheck ? -MATE_SCORE + ply : DRAW_SCORE;
+
+            // Not mated, but no check left to try: unproven
+            return DRAW_SCORE;
+        }
+
+        // Out of plies without a mate: unproven, which counts as a draw here
+        if (depth == 0) return DRAW_SCORE;
+
+        this->ttMove = 0;
+        orderMoves(game, movelist);
+
+        int bestScore = isAttacker ? DRAW_SCORE : -INF;
+
+        for (int i = 0; i < movelist.size(); i++)
+        {
+            checkTimer();
+            if (searchCancelled) break;
+
+            Move move = movelist[i];
+
+            std::vector<Move> childPV;
+
+            Board::makeMove(game, move, MAKE_MOVE_LIGHT);
+
+            int score = -mateSearch(game, depth - 1, -beta, -alpha, ply + 1, childPV);
+
+            Board::unmakeMove(game, MAKE_MOVE_LIGHT);
+
+            if (score > bestScore)
+            {
+                bestScore = score;
+
+                pv.clear();
+                pv.push_back(move);
+                pv.insert(pv.end(), childPV.begin(), childPV.end());
+            }
+
+            if (score > alpha) alpha = score;
+            if (alpha >= beta) break;
+        }
+
+        return bestScore;
+    }
+
+    Move Worker::searchMate(Rune::Game& game, int mateMoves, int thinkTimeMs, long long maxNodes)
     {
         startTime = Clock::now();
         thinkTime = thinkTimeMs;
+        nodeLimit = maxNodes;
         searchCancelled = false;
 
+        nodes = 0;
+        qnodes = 0;
+
         if (game.config.search.doInfo)
-            UCI::debug(__FILE__, "start with initialDepth=%d thinkTime=%d ms", initialDepth, thinkTimeMs);
-        
-        Move bookMove = 0;
-        
-        if (game.config.search.doOpeningBook) bookMove = OpeningBook::tryBookMove(game);
+            UCI::debug(__FILE__, "mate search with mateMoves=%d thinkTime=%d ms nodeLimit=%lld", mateMoves, thinkTimeMs, maxNodes);
+
+        Movegen::MoveList movelist;
+        requestMoves(game, movelist, NEGAMAX);
+
+        Move bestMove = (movelist.size() > 0) ? movelist[0] : 0;
 
-        if (bookMove && game.ply <= 12 && !game.outOfOpeningBook)
+        // Deepen one full move at a time so the first proof found is the shortest one
+        for (int n = 1; n <= mateMoves; n++)
         {
-            return bookMove;
+            std::vector<Move> pv;
+
+            selDepth = 0;
+
+            // Shorter mates were refuted by earlier passes, so this one only has to prove mate in exactly n:
+            // a null window on that score lets every attacker node stop at its first mating move
+            int depth = 2 * n - 1;
+            int score = mateSearch(game, depth, MATE_SCORE - depth - 1, MATE_SCORE - depth, 0, pv);
+
+            if (searchCancelled) break;
+
+            if (score > MATE_THRESHOLD && !pv.empty())
+            {
+                bestMove = pv[0];
+
+                game.pvLine.clear();
+
+                for (Move m : pv)
+                    game.pvLine += Board::moveToString(m) + " ";
+
+                if (game.config.search.doInfo)
+                    UCI::printSearchResult(depth, selDepth, 1, (MATE_SCORE - score + 1) / 2, true, nodes, getElapsedTime(), game.transpositionTable.hashfull(), game.pvLine);
+
+                break;
+            }
         }
-        else if (game.config.search.doOpeningBook)
+
+        if (game.config.search.doInfo)
+            UCI::debug(__FILE__, "timeUsed=%.0f ms nodes=%lld\n", getElapsedTime(), nodes);
+
+        return bestMove;
+    }
+
+    // -------------------------
+    // Entry point
+    // -------------------------
+    Move Worker::searchPosition(Rune::Game& game, int initialDepth, int thinkTimeMs, long long maxNodes, const std::vector<Move>& searchMoves)
+    {
+        startTime = Clock::now();
+        thinkTime = thinkTimeMs;
+        nodeLimit = maxNodes;
+        searchCancelled = false;
+
+        if (game.config.search.doInfo)
+            UCI::debug(__FILE__, "start with initialDepth=%d thinkTime=%d ms nodeLimit=%lld", initialDepth, thinkTimeMs, maxNodes);
+        
+        // A searchmoves restriction skips the book, its move need not be one of the listed ones
+        if (searchMoves.empty())
         {
-            game.outOfOpeningBook = true;
+            Move bookMove = 0;
+
+            if (game.config.search.doOpeningBook) bookMove = OpeningBook::tryBookMove(game);
+
+            if (bookMove && game.ply <= 12 && !game.outOfOpeningBook)
+            {
+                return bookMove;
+            }
+            else if (game.config.search.doOpeningBook)
+            {
+                game.outOfOpeningBook = true;
+            }
         }
 
         Move bestMoveSoFar = 0;
-        Movegen::MoveList movelist;
-        std::vector<Move> rootPV;
+
+        nodes = 0;
+        qnodes = 0;
+
+        // Root moves are generated and scored once, later iterations reorder them by what they learned
+        initRootMoves(game, searchMoves);
+
+        // Checkmated or stalemated, there is nothing to search
+        if (rootMoves.empty()) return 0;
+
+        // A forced move needs no search, unless searchmoves asked for the score of a single candidate
+        if (rootMoves.size() == 1 && searchMoves.empty()) return rootMoves[0].move;
+
+        // Never more slots than root moves, so every slot below indexes a real move
+        int multiPV = std::min(std::max(1, game.config.search.multiPV), (int) rootMoves.size());
 
         for (int depth = 1; depth <= initialDepth; depth++)
         {
@@ -541,94 +862,131 @@ namespace Search {
 
             if (game.config.search.doBetaCutoffHistory) updateBetaCutoffHistory();
 
-            Move bestThisDepth = 0;
-            int evalThisDepth = -INF;
             bool completed = true;
 
             lastDepthStartedAt = Clock::now();
 
-            // Probe TT for PV move to reorder
-            Move tmpBestMove = 0;
-            int tmpScore = 0;
-            if (game.config.search.doTranspositions) {
-                game.transpositionTable.probe(game.zobristKey, depth, -INF, INF, 0, tmpScore, tmpBestMove);
-                this->ttMove = tmpBestMove;
-            }
-
-            requestMoves(game, movelist, NEGAMAX);
+            selDepth = 0;
 
-            std::vector<Move> bestPV;
+            if (depth > 1) sortRootMoves(bestMoveSoFar);
 
-            if (movelist.size() == 1) return movelist[0];
+            for (RootMove& rootMove : rootMoves)
+                rootMove.nodes = 0;
 
-            for (int i = 0; i < movelist.size(); i++)
+            // Each PV slot searches the moves not yet claimed by an earlier slot, sharing TT and ordering
+            for (int pvIndex = 0; pvIndex < multiPV && completed; pvIndex++)
             {
-                checkTimer();
+                int evalThisSlot = -INF;
+                size_t bestIndex = pvIndex;
+
+                for (size_t i = pvIndex; i < rootMoves.size(); i++)
+                {
+                    checkTimer();
+
+                    if (searchCancelled) { completed = false; break; }
+
+                    RootMove& rootMove = rootMoves[i];
+                    Move move = rootMove.move;
+
+                    // Long iterations report which root move is being searched, not under a node limit where
+                    // a time-gated line would make the output depend on machine speed
+                    if (game.config.search.doInfo && nodeLimit == 0 && getElapsedTime() >= CURRMOVE_INFO_DELAY_MS)
+                        UCI::printCurrentMove(depth, move, (int) i + 1);
 
-                if (searchCancelled) { completed = false; break; }
+                    long long nodesBefore = nodes;
 
-                Move move = movelist[i];
-                Board::makeMove(game, move, MAKE_MOVE_FULL);
+                    Board::makeMove(game, move, MAKE_MOVE_FULL);
 
-                std::vector<Move> childPV;
+                    std::vector<Move> childPV;
 
-                int score;
-                if (i == 0) {
-                    // First move: full window
-                    score = -negamax(game, depth - 1, -INF, INF, 1, childPV);
-                } else {
-                    // PVS search
-                    score = -negamax(game, depth - 1, -evalThisDepth - 1, -evalThisDepth, 1, childPV);
-                    if (score > evalThisDepth) {
+                    int score;
+                    if (i == (size_t) pvIndex) {
+                        // First move: full window
                         score = -negamax(game, depth - 1, -INF, INF, 1, childPV);
+                    } else {
+                        // PVS search, re-searched with a full window so the slot score stays exact
+                        score = -negamax(game, depth - 1, -evalThisSlot - 1, -evalThisSlot, 1, childPV);
+                        if (score > evalThisSlot) {
+                            score = -negamax(game, depth - 1, -INF, INF, 1, childPV);
+                        }
                     }
-                }
 
-                Board::unmakeMove(game, MAKE_MOVE_FULL);
+                    Board::unmakeMove(game, MAKE_MOVE_FULL);
+
+                    rootMove.nodes += nodes - nodesBefore;
+
+                    if (searchCancelled) { completed = false; break; }
+
+                    rootMove.score = score;
+                    rootMove.pv.clear();
+                    rootMove.pv.push_back(move);
+                    rootMove.pv.insert(rootMove.pv.end(), childPV.begin(), childPV.end());
 
-                if (score > evalThisDepth) {
-                    evalThisDepth = score;
-                    bestThisDepth = move;
-                    bestPV.clear();
-                    bestPV.push_back(move);
-                    bestPV.insert(bestPV.end(), childPV.begin(), childPV.end());
+                    if (score > evalThisSlot) {
+                        evalThisSlot = score;
+                        bestIndex = i;
+                    }
                 }
+
+                if (!completed) break;
+
+                // Claim the slot so later slots exclude this move
+                std::rotate(rootMoves.begin() + pvIndex, rootMoves.begin() + bestIndex, rootMoves.begin() + bestIndex + 1);
             }
 
-            rootPV = bestPV;
+            lastDepthFinishedAt = Clock::now();
+
+            if (!completed) break;
+
+            // Later slots search with a TT the earlier slots already filled and can score above them,
+            // sorting only keeps the reported lines in order, the scores themselves stay as searched
+            std::stable_sort(rootMoves.begin(), rootMoves.begin() + multiPV, [](const RootMove &a, const RootMove &b) {
+                return a.score > b.score;
+            });
 
             game.pvLine.clear();
 
-            for (Move m : rootPV)
+            for (Move m : rootMoves[0].pv)
             {
                 game.pvLine += Board::moveToString(m) + " ";
             }
 
-            lastDepthFinishedAt = Clock::now();
-
             // Print info
-            if (completed && game.config.search.doInfo)
+            if (game.config.search.doInfo)
             {
-                bool isMate = (std::abs(evalThisDepth) > MATE_THRESHOLD);
-                int score = evalThisDepth;
-
-                if (isMate)
+                for (int pvIndex = 0; pvIndex < multiPV; pvIndex++)
                 {
-                    int mateIn = (MATE_SCORE - std::abs(evalThisDepth) + 1) / 2;
-                    mateIn = (mateIn == 0) ? 1 : mateIn;
-                    if (evalThisDepth < 0) mateIn = -mateIn;
-                    score = mateIn;
-                }
+                    const RootMove& rootMove = rootMoves[pvIndex];
+
+                    bool isMate = (std::abs(rootMove.score) > MATE_THRESHOLD);
+                    int score = rootMove.score;
 
-                UCI::printSearchResult(depth, score, getTimer(), isMate, game.pvLine);
+                    if (isMate)
+                    {
+                        int mateIn = (MATE_SCORE - std::abs(rootMove.score) + 1) / 2;
+                        mateIn = (mateIn == 0) ? 1 : mateIn;
+                        if (rootMove.score < 0) mateIn = -mateIn;
+                        score = mateIn;
+                    }
+
+                    std::string pvLine;
+
+                    for (Move m : rootMove.pv)
+                        pvLine += Board::moveToString(m) + " ";
+
+                    UCI::printSearchResult(depth, selDepth, pvIndex + 1, score, isMate, nodes, getElapsedTime(), game.transpositionTable.hashfull(), pvLine);
+                }
             }
-            else if (!completed) break;
 
-            bestMoveSoFar = bestThisDepth;
+            bestMoveSoFar = rootMoves[0].move;
         }
 
+        // Budget ran out before the first iteration finished, still answer with a legal move
+        if (bestMoveSoFar == 0 && !rootMoves.empty())
+            bestMoveSoFar = rootMoves[0].move;
+
         if (game.config.search.doInfo)
-            UCI::debug(__FILE__, "timeUsed=%.0f ms\n", getElapsedTime());
+            UCI::debug(__FILE__, "timeUsed=%.0f ms nodes=%lld qnodes=%lld\n", getElapsedTime(), nodes, qnodes);
 
         return bestMoveSoFar;
     }
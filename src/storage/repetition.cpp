@@ -1,7 +1,9 @@
 #include <storage/repetition.hpp>
+#include <tables/zobrist.hpp>
+#include <tables/table.hpp>
 #include <iostream>
 #include <string>
-#include <cstring>
+#include <algorithm>
 
 namespace Repetition {
     // Push a new hash; overwrites oldest if full
@@ -27,44 +29,71 @@ namespace Repetition {
 
     // Clear the table
     void Table::clear() {
-        memset(stack, 0, sizeof(stack));
         start = 0;
         count = 0;
     }
 
-    // Check threefold repetition
-    bool Table::checkThreefold(ZobristHash hash) {
+    // Check repetition of the last pushed hash
+    bool Table::isRepetition(int window, int ply) const {
+        if (count == 0) return false;
+
+        // Nothing before the last irreversible move can repeat, and the first candidate is four plies back
+        size_t end = std::min(static_cast<size_t>(window), count - 1);
+        if (end < 4) return false;
+
+        size_t top = (start + count - 1) % REPETITION_SIZE;
+        ZobristHash hash = stack[top];
         int matches = 0;
 
-        for (size_t i = 0; i < count; ++i) {
-            size_t idx = (start + i) % REPETITION_SIZE;
-            if (stack[idx] == hash)
-            {
-                ++matches;
+        // Same side to move only, so every other entry, walking down from four plies back
+        size_t index = (top >= 4) ? top - 4 : top + REPETITION_SIZE - 4;
+
+        for (size_t i = 4; i <= end; i += 2, index = (index >= 2) ? index - 2 : index + REPETITION_SIZE - 2) {
+            if (stack[index] == hash) {
+                if (static_cast<int>(i) < ply || ++matches == 2) return true;
             }
-            if (matches >= 3) return true;
         }
+
         return false;
     }
 
-    // Check last `recentMoves` hashes only
-    bool Table::checkThreefoldRecent(size_t recentMoves) {
-        int matches = 0;
-        size_t movesToCheck = (recentMoves < count) ? recentMoves : count;
+    // Check for a move that repeats a position
+    bool Table::hasUpcomingRepetition(Bitboard occupancy, int window, int ply) const {
+        if (count == 0) return false;
+
+        // Odd distances, the older position has the other side to move
+        size_t end = std::min(static_cast<size_t>(window), count - 1);
+        if (end < 3) return false;
 
-        for (size_t i = count - movesToCheck; i < count; ++i) {
-            size_t idx = (start + i) % REPETITION_SIZE;
-            if (stack[idx] == stack[(start + count - 1) % REPETITION_SIZE]) {
-                ++matches;
-                if (matches >= 3) return true;
+        size_t top = (start + count - 1) % REPETITION_SIZE;
+        ZobristHash hash = stack[top];
+
+        // Past the search tree a single cycle is not yet a draw
+        end = std::min(end, static_cast<size_t>(std::max(ply - 1, 0)));
+
+        size_t index = (top >= 3) ? top - 3 : top + REPETITION_SIZE - 3;
+
+        for (size_t i = 3; i <= end; i += 2, index = (index >= 2) ? index - 2 : index + REPETITION_SIZE - 2) {
+            ZobristHash moveKey = hash ^ stack[index];
+
+            int slot = Zobrist::cuckooH1(moveKey);
+            if (Zobrist::cuckoo.keys[slot] != moveKey) {
+                slot = Zobrist::cuckooH2(moveKey);
+                if (Zobrist::cuckoo.keys[slot] != moveKey) continue;
             }
+
+            Move move = Zobrist::cuckoo.moves[slot];
+
+            // The move is only playable if nothing stands in its way
+            if (!(PrecomputedTables::attackTable.between[Helpers::get_from(move)][Helpers::get_to(move)] & occupancy))
+                return true;
         }
 
         return false;
     }
 
-    bool Table::checkFiftyMoveRule()
+    bool Table::checkFiftyMoveRule(int fiftyMoveCounter)
     {
-        return this->fiftyMoveCounter >= 50;
+        return fiftyMoveCounter >= 50;
     }
 } // namespace Repetition
\ No newline at end of file
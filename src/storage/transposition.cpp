@@ -1,5 +1,6 @@
 #include <storage/transposition.hpp>
 #include <core/rune.hpp>
+#include <tables/helpers.hpp>
 
 #include <stdbool.h>
 #include <string.h>
@@ -52,13 +53,26 @@ namespace Transposition {
 
         if (entry->key != key || depth >= entry->depth) {
             entry->key = key;
-            entry->depth = depth;
+            entry->depth = Helpers::clamp(depth, 0, 255);
             entry->eval = storeEval(eval, ply);
             entry->flag = flag;
             entry->best_move = best_move;
         }
     }
 
+    int Table::hashfull() {
+        const size_t sample = std::min(TT_SIZE, (size_t) 1000);
+
+        size_t used = 0;
+
+        for (size_t i = 0; i < sample; i++)
+        {
+            if (this->table[i].key != 0) used++;
+        }
+
+        return (int) (used * 1000 / sample);
+    }
+
     void Table::clear() {
         std::fill(
             this->table,
@@ -0,0 +1,199 @@
+#include <tables/magic.hpp>
+
+#include <cassert>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+namespace Magic {
+    SquareMagic bishopMagics[64];
+    SquareMagic rookMagics[64];
+
+    bool usePext = false;
+
+    // Packed attack tables, each square owns a 2^bits slice starting at its pointer
+    static Bitboard bishopTable[BISHOP_TABLE_SIZE];
+    static Bitboard rookTable[ROOK_TABLE_SIZE];
+
+    static constexpr int BISHOP_DIRECTIONS[4][2] = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+    static constexpr int ROOK_DIRECTIONS[4][2]   = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+
+    // ----------------------------
+    // CPU detection
+    // ----------------------------
+    bool hasFastPext()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        unsigned int eax, ebx, ecx, edx;
+
+        if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) || !(ebx & bit_BMI2))
+            return false;
+
+        char vendor[13] = {};
+        __get_cpuid(0, &eax, &ebx, &ecx, &edx);
+        std::memcpy(vendor,     &ebx, 4);
+        std::memcpy(vendor + 4, &edx, 4);
+        std::memcpy(vendor + 8, &ecx, 4);
+
+        if (std::strcmp(vendor, "AuthenticAMD") == 0)
+        {
+            __get_cpuid(1, &eax, &ebx, &ecx, &edx);
+
+            unsigned int family = (eax >> 8) & 0xF;
+            if (family == 0xF) family += (eax >> 20) & 0xFF;
+
+            // Zen 1 and 2 (family 17h) and older run PEXT in microcode, Zen 3 is 19h
+            return family >= 0x19;
+        }
+
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // ----------------------------
+    // Table generation
+    // ----------------------------
+
+    // Ray walk used only to build the tables, stops on the first blocker
+    static Bitboard slidingAttacks(int square, Bitboard occupancy, const int directions[4][2])
+    {
+        Bitboard attacks = 0ULL;
+
+        for (int d = 0; d < 4; d++)
+        {
+            int rank = square / 8 + directions[d][0];
+            int file = square % 8 + directions[d][1];
+
+            while (rank >= 0 && rank < 8 && file >= 0 && file < 8)
+            {
+                Bitboard bit = 1ULL << (rank * 8 + file);
+                attacks |= bit;
+
+                if (occupancy & bit) break;
+
+                rank += directions[d][0];
+                file += directions[d][1];
+            }
+        }
+
+        return attacks;
+    }
+
+    // xorshift64*, seeded deterministically so every run finds the same magics
+    static uint64_t nextRandom(uint64_t& state)
+    {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 2685821657736338717ULL;
+    }
+
+    // Candidates with few set bits are far more likely to be magic
+    static uint64_t sparseRandom(uint64_t& state)
+    {
+        return nextRandom(state) & nextRandom(state) & nextRandom(state);
+    }
+
+    // Seeds per rank that reach a magic within a few hundred candidates
+    static constexpr uint64_t RANK_SEEDS[8] = {728, 10316, 55013, 32803, 12281, 15100, 16645, 255};
+
+    static void initPiece(SquareMagic magics[64], Bitboard* table, const int directions[4][2], bool pext)
+    {
+        static Bitboard occupancies[4096];
+        static Bitboard reference[4096];
+        static int epoch[4096];
+        int attempt = 0;
+
+        std::memset(epoch, 0, sizeof(epoch));
+
+        for (int square = 0; square < 64; square++)
+        {
+            SquareMagic& m = magics[square];
+
+            // A blocker on the board edge never shortens a ray, unless the piece stands on that edge
+            Bitboard edges = ((RANK_1 | RANK_8) & ~(RANK_1 << (square & 56))) |
+                             ((FILE_A | FILE_H) & ~(FILE_A << (square & 7)));
+
+            m.mask        = slidingAttacks(square, 0ULL, directions) & ~edges;
+            m.shift       = 64 - __builtin_popcountll(m.mask);
+            m.attacks     = table;
+
+            // Carry-rippler walks the subsets of the mask in the order PEXT numbers them
+            int size = 0;
+            Bitboard subset = 0ULL;
+            do {
+                occupancies[size] = subset;
+                reference[size]   = slidingAttacks(square, subset, directions);
+                size++;
+                subset = (subset - m.mask) & m.mask;
+            } while (subset);
+
+            table += size;
+
+            // PEXT indexes the subsets directly, no magic needed
+            if (pext)
+            {
+                m.magic = 0ULL;
+                std::memcpy(m.attacks, reference, size * sizeof(Bitboard));
+                continue;
+            }
+
+            // Try candidates until every subset maps to a slot holding its own attack set
+            uint64_t seed = RANK_SEEDS[square / 8];
+
+            for (int i = 0; i < size; )
+            {
+                do {
+                    m.magic = sparseRandom(seed);
+                } while (__builtin_popcountll((m.magic * m.mask) >> 56) < 6);
+
+                attempt++;
+
+                for (i = 0; i < size; i++)
+                {
+                    unsigned index = static_cast<unsigned>((occupancies[i] * m.magic) >> m.shift);
+
+                    // Stale slots from earlier attempts count as empty
+                    if (epoch[index] < attempt)
+                    {
+                        epoch[index] = attempt;
+                        m.attacks[index] = reference[i];
+                    }
+                    else if (m.attacks[index] != reference[i])
+                        break;
+                }
+            }
+        }
+    }
+
+    void build(bool pext)
+    {
+        initPiece(bishopMagics, bishopTable, BISHOP_DIRECTIONS, pext);
+        initPiece(rookMagics,   rookTable,   ROOK_DIRECTIONS,   pext);
+
+        assert(bishopMagics[63].attacks + (1ULL << (64 - bishopMagics[63].shift)) == bishopTable + BISHOP_TABLE_SIZE);
+        assert(rookMagics[63].attacks   + (1ULL << (64 - rookMagics[63].shift))   == rookTable   + ROOK_TABLE_SIZE);
+
+        usePext = pext;
+    }
+
+    void init()
+    {
+        // Function-local static, so Games constructed on several threads build the tables exactly once
+        static const bool initialized = [] {
+#if defined(__BMI2__)
+            build(hasFastPext());
+#else
+            build(false);
+#endif
+            return true;
+        }();
+
+        (void)initialized;
+    }
+
+} // namespace Magic
@@ -1,181 +1,124 @@
 #include <tables/table.hpp>
-#include <tables/magic.hpp>
 
-#include <cmath>    // for std::abs
 #include <cstdint>
 
 namespace PrecomputedTables {
 
-    constexpr int KNIGHT_OFFSETS[8] = {17, 10, 6, 15, -6, -15, -17, -10};
+    // {rank, file} steps
+    static constexpr int KING_STEPS[8][2]        = {{1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}, {0, -1}, {1, -1}};
+    static constexpr int KNIGHT_STEPS[8][2]      = {{2, 1}, {1, 2}, {-1, 2}, {-2, 1}, {-2, -1}, {-1, -2}, {1, -2}, {2, -1}};
+    static constexpr int PAWN_STEPS[2][2][2]     = {{{1, -1}, {1, 1}}, {{-1, -1}, {-1, 1}}};
+    static constexpr int BISHOP_DIRECTIONS[4][2] = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+    static constexpr int ROOK_DIRECTIONS[4][2]   = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+
+    static constexpr bool onBoard(int rank, int file)
+    {
+        return rank >= 0 && rank < 8 && file >= 0 && file < 8;
+    }
 
     // ----------------------------
-    // King attacks
+    // Leaper attacks (king, knight, pawn)
     // ----------------------------
-    void AttackTable::preComputeKing()
+    static constexpr Bitboard stepAttacks(int square, const int steps[][2], int count)
     {
-        for (int square = 0; square < 64; ++square) {
-            Bitboard moves = 0ULL;
-            int rank = square / 8;
-            int file = square % 8;
-
-            int offsets[8] = {8, 9, 1, -7, -8, -9, -1, 7};
+        Bitboard attacks = 0ULL;
 
-            for (int i = 0; i < 8; ++i) {
-                int target = square + offsets[i];
-                if (target < 0 || target >= 64) continue;
-
-                int target_rank = target / 8;
-                int target_file = target % 8;
-
-                if (std::abs(target_rank - rank) <= 1 && std::abs(target_file - file) <= 1) {
-                    moves |= 1ULL << target;
-                }
-            }
+        for (int i = 0; i < count; i++)
+        {
+            int rank = square / 8 + steps[i][0];
+            int file = square % 8 + steps[i][1];
 
-            this->pieces[KING][square] = moves;
+            if (onBoard(rank, file)) attacks |= 1ULL << (rank * 8 + file);
         }
+
+        return attacks;
     }
 
     // ----------------------------
-    // Knight attacks
+    // Empty-board slider attacks
     // ----------------------------
-    void AttackTable::preComputeKnight()
+    static constexpr Bitboard rayAttacks(int square, const int directions[4][2])
     {
-        for (int square = 0; square < 64; ++square)
-        {
-            int rank = square / 8;
-            int file = square % 8;
-            Bitboard moves = 0ULL;
+        Bitboard attacks = 0ULL;
 
-            // All 8 knight offsets
-            constexpr int offsets[8] = {17, 15, 10, 6, -17, -15, -10, -6};
+        for (int d = 0; d < 4; d++)
+        {
+            int rank = square / 8 + directions[d][0];
+            int file = square % 8 + directions[d][1];
 
-            for (int i = 0; i < 8; ++i)
+            while (onBoard(rank, file))
             {
-                int target = square + offsets[i];
-
-                if (target < 0 || target >= 64) continue;
-
-                int targetRank = target / 8;
-                int targetFile = target % 8;
-
-                // Ensure the move does not wrap around the board horizontally
-                if (std::abs(targetFile - file) > 2) continue;
-                if (std::abs(targetRank - rank) > 2) continue;
-
-                moves |= 1ULL << target;
+                attacks |= 1ULL << (rank * 8 + file);
+                rank += directions[d][0];
+                file += directions[d][1];
             }
-
-            this->pieces[KNIGHT][square] = moves;
         }
-    }
-
-    // ----------------------------
-    // Sliding attacks (bishop, rook, queen)
-    // ----------------------------
-    void AttackTable::preComputeSliding(int piece_type) {
-        for (int square = 0; square < 64; ++square) {
-            Bitboard attacks = 0ULL;
-            switch (piece_type) {
-                case BISHOP:
-                    attacks = Magic::getBishopAttacks(square, 0ULL);
-                    break;
-                case ROOK:
-                    attacks = Magic::getRookAttacks(square, 0ULL);
-                    break;
-                case QUEEN:
-                    attacks = Magic::getQueenAttacks(square, 0ULL);
-                    break;
-                default:
-                    continue;
-            }
 
-            this->pieces[piece_type][square] = attacks;
-        }
+        return attacks;
     }
 
     // ----------------------------
-    // Pawn attacks
+    // Build every table
     // ----------------------------
-    void AttackTable::preComputePawn(int color) {
-        int left_offset  = (color == WHITE) ? 7  : -9;
-        int right_offset = (color == WHITE) ? 9  : -7;
-
-        for (int square = 0; square < 64; ++square) {
-            int file = square % 8;
-            Bitboard attacks = 0ULL;
-
-            if (file > 0) {
-                int target = square + left_offset;
-                if (target >= 0 && target < 64) attacks |= 1ULL << target;
-            }
-            if (file < 7) {
-                int target = square + right_offset;
-                if (target >= 0 && target < 64) attacks |= 1ULL << target;
-            }
+    static constexpr AttackTable build()
+    {
+        AttackTable table{};
 
-            this->pawns[color][square] = attacks;
+        for (int square = 0; square < 64; square++)
+        {
+            table.pawns[WHITE][square]     = stepAttacks(square, PAWN_STEPS[WHITE], 2);
+            table.pawns[BLACK][square]     = stepAttacks(square, PAWN_STEPS[BLACK], 2);
+            table.pieces[KNIGHT][square]   = stepAttacks(square, KNIGHT_STEPS, 8);
+            table.pieces[KING][square]     = stepAttacks(square, KING_STEPS, 8);
+            table.pieces[BISHOP][square]   = rayAttacks(square, BISHOP_DIRECTIONS);
+            table.pieces[ROOK][square]     = rayAttacks(square, ROOK_DIRECTIONS);
+            table.pieces[QUEEN][square]    = table.pieces[BISHOP][square] | table.pieces[ROOK][square];
         }
-    }
 
-    // ----------------------------
-    // Castling rights lookup
-    // ----------------------------
-    void AttackTable::preComputeCastling() {
-        for (int from = 0; from < 64; ++from) {
-            for (int to = 0; to < 64; ++to) {
-                uint8_t rights = CASTLING_ALL;
+        // Between & line masks: walk each ray, every square reached sees the ones passed so far
+        for (int a = 0; a < 64; a++)
+        {
+            for (int d = 0; d < 8; d++)
+            {
+                int dr = KING_STEPS[d][0];
+                int df = KING_STEPS[d][1];
+
+                // Full line through a in this direction and its opposite
+                Bitboard line = 1ULL << a;
+                for (int sign = -1; sign <= 1; sign += 2)
+                {
+                    int rank = a / 8 + dr * sign;
+                    int file = a % 8 + df * sign;
+
+                    while (onBoard(rank, file))
+                    {
+                        line |= 1ULL << (rank * 8 + file);
+                        rank += dr * sign;
+                        file += df * sign;
+                    }
+                }
 
-                if (from == 4) rights &= ~(WHITE_KINGSIDE | WHITE_QUEENSIDE);
-                if (from == 60) rights &= ~(BLACK_KINGSIDE | BLACK_QUEENSIDE);
+                Bitboard passed = 0ULL;
+                int rank = a / 8 + dr;
+                int file = a % 8 + df;
 
-                if (from == 0) rights &= ~WHITE_QUEENSIDE;
-                if (from == 7) rights &= ~WHITE_KINGSIDE;
-                if (from == 56) rights &= ~BLACK_QUEENSIDE;
-                if (from == 63) rights &= ~BLACK_KINGSIDE;
+                while (onBoard(rank, file))
+                {
+                    int b = rank * 8 + file;
 
-                if (to == 0) rights &= ~WHITE_QUEENSIDE;
-                if (to == 7) rights &= ~WHITE_KINGSIDE;
-                if (to == 56) rights &= ~BLACK_QUEENSIDE;
-                if (to == 63) rights &= ~BLACK_KINGSIDE;
+                    table.between[a][b] = passed;
+                    table.line[a][b]    = line;
 
-                this->castling[from][to] = rights;
+                    passed |= 1ULL << b;
+                    rank += dr;
+                    file += df;
+                }
             }
         }
-    }
 
-    // ----------------------------
-    // Precompute all attacks
-    // ----------------------------
-    void AttackTable::preComputeAll() {
-        preComputePawn(WHITE);
-        preComputePawn(BLACK);
-        preComputeKnight();
-        preComputeSliding(BISHOP);
-        preComputeSliding(ROOK);
-        preComputeSliding(QUEEN);
-        preComputeCastling();
-        preComputeKing();
-    }
-
-    Bitboard AttackTable::getPawnAttacks(int color, int square)
-    {
-        return this->pawns[color][square];
-    }
-
-    Bitboard AttackTable::getKnightAttacks(int square)
-    {
-        return this->pieces[KNIGHT][square];
-    }
-
-    Bitboard AttackTable::getKingAttacks(int square)
-    {
-        return this->pieces[KING][square];
+        return table;
     }
 
-    Bitboard AttackTable::getSlidingAttacks(int square, PieceType type)
-    {
-        return this->pieces[type][square];
-    }
+    constexpr AttackTable attackTable = build();
 
-} // namespace PrecomputedTables
\ No newline at end of file
+} // namespace PrecomputedTables
@@ -2,7 +2,6 @@
 #include <storage/transposition.hpp>
 #include <core/board.hpp>
 
-#include <random>
 #include <sstream>
 #include <iomanip>
 #include <iostream>
@@ -13,162 +12,147 @@ namespace Rune {
 }
 
 namespace Zobrist {
-    ZobristHash zobrist_pieces[12][NUM_SQUARES];   // 6 types * 2 colors
-    ZobristHash zobrist_castling[NUM_CASTLING];
-    ZobristHash zobrist_enpassant[NUM_ENPASSANT];
-    ZobristHash zobrist_turn;
-
-    // piece_to_index[color][piece_type]
-    // piece_type must be 0..5 (Pawn, Knight, Bishop, Rook, Queen, King)
-    const int piece_to_index[2][6] = {
-        {0, 1, 2, 3, 4, 5},       // white
-        {6, 7, 8, 9, 10, 11}      // black
-    };
-
     // ----------------------------
     // Compute full hash
     // ----------------------------
-    ZobristHash compute(Rune::Game& game) {
+    ZobristHash compute(const Rune::Position& position) {
         ZobristHash hash = 0ULL;
 
-        Bitboard occupancy = game.occupancy[BOTH];
+        Bitboard occupancy = position.occupancy[BOTH];
 
         while (occupancy) {
             int square = __builtin_ctzll(occupancy);
 
-            Piece piece = game.boardGhost[square];
-            int color = Helpers::get_color(piece);
-            int type  = Helpers::get_type(piece); // must be 0..5
-
-            hash ^= zobrist_pieces[piece_to_index[color][type]][square];
+            hash ^= pieceKey(position.boardGhost[square], square);
             occupancy &= occupancy - 1;
         }
 
-        // Castling rights (per-bit hashing)
-        for (int bit = 0; bit < 4; ++bit) {
-            int mask = 1 << bit;
-            if (game.castlingRights & mask) {
-                hash ^= zobrist_castling[bit];
-            }
-        }
+        // Castling rights, one key per rights combination
+        hash ^= castlingKey(position.castlingRights);
 
         // En passant
-        if (game.enpassantSquare != -1) {
-            int file = game.enpassantSquare & 7;
-            hash ^= zobrist_enpassant[file];
+        if (position.enpassantSquare != -1) {
+            int file = position.enpassantSquare & 7;
+            hash ^= enpassantKey(file);
         }
 
         // Side to move
-        if (game.turn == BLACK) {
-            hash ^= zobrist_turn;
+        if (position.turn == BLACK) {
+            hash ^= turnKey();
         }
 
         return hash;
     }
 
     // ----------------------------
-    // Update hash after a move
+    // Full recompute (for safety)
     // ----------------------------
-    void updateMove(Rune::Game& game, Move move, Rune::State& oldState) {
-        int from  = Helpers::get_from(move);
-        int to    = Helpers::get_to(move);
-        int color = game.turn; // side before making move
-
-        ZobristHash hash = game.zobristKey;
-
-        Piece moved_piece = game.boardGhost[from];
-        Piece captured_piece = EMPTY;
+    void updateBoard(Rune::Position& position) {
+        position.zobristKey = compute(position);
+    }
 
-        if (Helpers::is_enpassant(move)) {
-            int ep_sq = (color == WHITE) ? (to - 8) : (to + 8);
-            captured_piece = game.boardGhost[ep_sq];
-        } else {
-            captured_piece = game.boardGhost[to];
-        }
+    // ----------------------------
+    // Key generation (compile time)
+    // ----------------------------
 
-        // Remove moved piece from "from"
-        hash ^= zobrist_pieces[piece_to_index[Helpers::get_color(moved_piece)][Helpers::get_type(moved_piece)]][from];
+    // splitmix64, fixed seed so keys are the same on every build
+    static constexpr uint64_t nextKey(uint64_t& state) {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
 
-        // Remove captured piece
-        if (captured_piece != EMPTY) {
-            int cap_sq = Helpers::is_enpassant(move) ? ((color == WHITE) ? to - 8 : to + 8) : to;
-            hash ^= zobrist_pieces[piece_to_index[Helpers::get_color(captured_piece)][Helpers::get_type(captured_piece)]][cap_sq];
-        }
+    static constexpr Keys generateKeys() {
+        Keys generated{};
+        uint64_t state = 12345678ULL;
 
-        // Add moved/promo piece to "to"
-        Piece piece_to_hash = moved_piece;
-        if (Helpers::is_promo(move)) {
-            piece_to_hash = Helpers::make_piece(Helpers::get_promo(move), color);
-        }
-        hash ^= zobrist_pieces[piece_to_index[Helpers::get_color(piece_to_hash)][Helpers::get_type(piece_to_hash)]][to];
-
-        // Handle castling rook moves
-        if (Helpers::is_castle(move)) {
-            int rook_from = -1, rook_to = -1;
-            if (color == WHITE) {
-                if (to == 6) { rook_from = 7; rook_to = 5; }
-                else if (to == 2) { rook_from = 0; rook_to = 3; }
-            } else {
-                if (to == 62) { rook_from = 63; rook_to = 61; }
-                else if (to == 58) { rook_from = 56; rook_to = 59; }
-            }
-            if (rook_from != -1) {
-                hash ^= zobrist_pieces[piece_to_index[color][ROOK]][rook_from];
-                hash ^= zobrist_pieces[piece_to_index[color][ROOK]][rook_to];
+        for (int p = 0; p < NUM_PIECE_TYPES; p++) {
+            for (int sq = 0; sq < NUM_SQUARES; sq++) {
+                generated.pieces[p][sq] = nextKey(state);
             }
         }
-
-        // Update castling rights (per-bit)
-        for (int bit = 0; bit < 4; ++bit) {
-            int mask = 1 << bit;
-            if (oldState.castlingRights & mask) hash ^= zobrist_castling[bit];
-            if (game.castlingRights    & mask) hash ^= zobrist_castling[bit];
+        // One key per right (0=W_OO,1=W_OOO,2=B_OO,3=B_OOO), each combination is the XOR of its rights
+        ZobristHash castling_rights[4] = {};
+        for (int i = 0; i < 4; i++) {
+            castling_rights[i] = nextKey(state);
         }
-
-        // Update en passant
-        if (oldState.enpassantSquare != -1) {
-            int old_file = oldState.enpassantSquare & 7;
-            hash ^= zobrist_enpassant[old_file];
+        for (int rights = 0; rights < NUM_CASTLING; rights++) {
+            for (int bit = 0; bit < 4; bit++) {
+                if (rights & (1 << bit)) generated.castling[rights] ^= castling_rights[bit];
+            }
         }
-        if (game.enpassantSquare != -1) {
-            int new_file = game.enpassantSquare & 7;
-            hash ^= zobrist_enpassant[new_file];
+        for (int i = 0; i < NUM_ENPASSANT; i++) {
+            generated.enpassant[i] = nextKey(state);
         }
+        generated.turn = nextKey(state);
 
-        // Toggle side to move
-        hash ^= zobrist_turn;
-
-        game.zobristKey = hash; // ✅ always carry updated key forward
+        return generated;
     }
 
+    constexpr Keys keys = generateKeys();
+
     // ----------------------------
-    // Full recompute (for safety)
+    // Cuckoo tables (compile time)
     // ----------------------------
-    void updateBoard(Rune::Game& game) {
-        game.zobristKey = compute(game);
+
+    // Whether a piece can go between two squares on an empty board
+    static constexpr bool reaches(int type, int from, int to) {
+        int dr = to / 8 - from / 8; if (dr < 0) dr = -dr;
+        int df = to % 8 - from % 8; if (df < 0) df = -df;
+
+        switch (type) {
+            case KNIGHT: return (dr == 1 && df == 2) || (dr == 2 && df == 1);
+            case BISHOP: return dr == df && dr != 0;
+            case ROOK:   return (dr == 0) != (df == 0);
+            case QUEEN:  return (dr == df && dr != 0) || ((dr == 0) != (df == 0));
+            case KING:   return dr <= 1 && df <= 1 && (dr | df) != 0;
+            default:     return false;
+        }
     }
 
-    // ----------------------------
-    // Init keys (better RNG)
-    // ----------------------------
-    void init() {
-        std::mt19937_64 rng(12345678ULL);
-        std::uniform_int_distribution<uint64_t> dist;
+    static constexpr Cuckoo generateCuckoo() {
+        Cuckoo table{};
 
-        for (int p = 0; p < 12; p++) {
-            for (int sq = 0; sq < NUM_SQUARES; sq++) {
-                zobrist_pieces[p][sq] = dist(rng);
+        for (int color = WHITE; color <= BLACK; color++) {
+            for (int type = KNIGHT; type <= KING; type++) {
+                const int index = piece_to_index[color][type];
+
+                for (int s1 = 0; s1 < NUM_SQUARES; s1++) {
+                    for (int s2 = s1 + 1; s2 < NUM_SQUARES; s2++) {
+                        if (!reaches(type, s1, s2)) continue;
+
+                        ZobristHash key = keys.pieces[index][s1] ^ keys.pieces[index][s2] ^ keys.turn;
+                        Move move = Helpers::make_move(s1, s2, MOVE_QUIET);
+
+                        // Insert, kicking the occupant to its other slot until one lands in an empty slot
+                        int slot = cuckooH1(key);
+                        while (true) {
+                            ZobristHash keptKey = table.keys[slot];
+                            Move keptMove = table.moves[slot];
+                            table.keys[slot] = key;
+                            table.moves[slot] = move;
+
+                            if (keptMove == 0) break;
+
+                            key = keptKey;
+                            move = keptMove;
+                            slot = (slot == cuckooH1(key)) ? cuckooH2(key) : cuckooH1(key);
+                        }
+
+                        table.count++;
+                    }
+                }
             }
         }
-        for (int i = 0; i < 4; i++) { // 0=W_OO,1=W_OOO,2=B_OO,3=B_OOO
-            zobrist_castling[i] = dist(rng);
-        }
-        for (int i = 0; i < NUM_ENPASSANT; i++) {
-            zobrist_enpassant[i] = dist(rng);
-        }
-        zobrist_turn = dist(rng);
+
+        return table;
     }
 
+    constexpr Cuckoo cuckoo = generateCuckoo();
+
+    static_assert(cuckoo.count == 3668, "Cuckoo table must hold every reversible piece move");
+
     // ----------------------------
     // Hash to string
     // ----------------------------
@@ -6,6 +6,7 @@
 #include <cstring>
 #include <cstdlib>
 #include <sstream>
+#include <algorithm>
 
 namespace Rune {
     class Game;
@@ -57,6 +58,9 @@ namespace Config {
     void set_search_beta_cutoff_history(Rune::Game& game, const char* value) {
         game.config.search.doBetaCutoffHistory = std::atoi(value) != 0;
     }
+    void set_search_see_pruning(Rune::Game& game, const char* value) {
+        game.config.search.doSeePruning = std::atoi(value) != 0;
+    }
     void set_search_info(Rune::Game& game, const char* value) {
         game.config.search.doInfo = std::atoi(value) != 0;
     }
@@ -72,6 +76,9 @@ namespace Config {
     void set_search_opening_book(Rune::Game& game, const char* value) {
         game.config.search.doOpeningBook = std::atoi(value) != 0;
     }
+    void set_search_multi_pv(Rune::Game& game, const char* value) {
+        game.config.search.multiPV = std::max(1, std::atoi(value));
+    }
 
     // --- Option registry ---
     OptionHandler option_table[] = {
@@ -91,11 +98,13 @@ namespace Config {
         { "searchDoQuiescense",           set_search_quiescense },
         { "searchDoTranspositions",       set_search_transpositions },
         { "searchDoBetaCutoffHistory",  set_search_beta_cutoff_history },
+        { "searchDoSeePruning",           set_search_see_pruning },
         { "searchDoInfo",                 set_search_info },
         { "searchInitialDepth",           set_search_initial_depth },
         { "searchMaximumDepth",           set_search_maximum_depth },
         { "searchMaximumQuiescenseDepth",set_search_quiescense_depth },
         { "searchDoOpeningBook",         set_search_opening_book },
+        { "MultiPV",                      set_search_multi_pv },
 
         { nullptr, nullptr }
     };
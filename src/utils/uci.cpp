@@ -4,6 +4,7 @@
 #include <stdio.h>
 #include <time.h>
 #include <string>
+#include <vector>
 #include <cmath>
 #include <cstdlib>
 #include <iostream>
@@ -50,19 +51,30 @@ namespace UCI {
         std::cerr << std::endl;
     }
 
-    void printSearchResult(int depth, int score, int timeMs, bool isMate, std::string pvCurrent)
+    void printSearchResult(int depth, int selDepth, int multiPV, int score, bool isMate, long long nodes, int timeMs, int hashfull, std::string pvCurrent)
     {
-        std::cout << "info depth " << depth << " score";
+        // No rate can be measured over a zero interval
+        long long nps = (timeMs > 0) ? (nodes * 1000 / timeMs) : 0;
+
+        std::cout << "info depth " << depth << " seldepth " << selDepth << " multipv " << multiPV << " score";
 
         if (isMate)
             std::cout << " mate " << score << " ";
         else
             std::cout << " cp " << score << " ";
         
+        std::cout << "nodes " << nodes << " ";
+        std::cout << "nps " << nps << " ";
+        std::cout << "hashfull " << hashfull << " ";
         std::cout << "time " << static_cast<int>(timeMs) << " ";
         std::cout << "pv " << pvCurrent << std::endl;
     }
 
+    void printCurrentMove(int depth, Move move, int moveNumber)
+    {
+        std::cout << "info depth " << depth << " currmove " << Board::moveToString(move) << " currmovenumber " << moveNumber << std::endl;
+    }
+
     void uciLoop(Rune::Game& game)
     {
         char input[4096];
@@ -76,6 +88,7 @@ namespace UCI {
             {
                 std::cout << "id name " << __UCI_VERSION__ << std::endl;
                 std::cout << "id author " << __UCI_AUTHOR__ << std::endl;
+                std::cout << "option name MultiPV type spin default 1 min 1 max " << MAX_MOVES << std::endl;
                 std::cout << "uciok" << std::endl;
 
                 fflush(stdout);
@@ -137,8 +150,6 @@ namespace UCI {
             {
                 char *ptr = input + 9;
 
-                game.repetitionTable.clear();
-
                 if (strncmp(ptr, "startpos", 8) == 0)
                 {
                     Board::loadFen(game, "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
@@ -199,14 +210,63 @@ namespace UCI {
             {
                 Perft::runTests(game);
             }
+            else if (strncmp(input, "go attacktest", 13) == 0)
+            {
+                Perft::attackTest(game, 20);
+            }
+            else if (strncmp(input, "go checktest", 12) == 0)
+            {
+                Perft::checkTest(game, 20);
+            }
+            else if (strncmp(input, "go searchtest", 13) == 0)
+            {
+                Perft::searchTest(game);
+            }
+            else if (strncmp(input, "go perftbench", 13) == 0)
+            {
+                Perft::bench(game);
+            }
+            else if (strncmp(input, "go makebench", 12) == 0)
+            {
+                Perft::makeBench(game, 1000);
+            }
+            else if (strncmp(input, "go magicbench", 13) == 0)
+            {
+                Perft::magicBench(50000000);
+            }
             else if (strncmp(input, "go", 2) == 0)
             {
                 char *ptr = input + 2;
                 int wtime = -1, btime = -1, winc = 0, binc = 0;
                 int movestogo = 30, depth = -1, movetime = -1;
+                long long nodes = -1;
+                int mate = -1;
+                std::vector<Move> searchMoves;
 
                 while (*ptr)
                 {
+                    // searchmoves takes every following token that reads as a move
+                    if (strncmp(ptr, "searchmoves", 11) == 0)
+                    {
+                        ptr += 11;
+                        while (*ptr == ' ') ptr++;
+
+                        while (*ptr >= 'a' && *ptr <= 'h' && ptr[1] >= '1' && ptr[1] <= '8')
+                        {
+                            char move_str[6];
+
+                            if (sscanf(ptr, "%5s", move_str) != 1) break;
+
+                            searchMoves.push_back(Board::parseMove(game, move_str));
+
+                            ptr += strcspn(ptr, " ");
+
+                            while (*ptr == ' ') ptr++;
+                        }
+
+                        continue;
+                    }
+
                     if (strncmp(ptr, "wtime", 5) == 0) { ptr += 5; while (*ptr == ' ') ptr++; wtime = atoi(ptr); }
                     else if (strncmp(ptr, "btime", 5) == 0) { ptr += 5; while (*ptr == ' ') ptr++; btime = atoi(ptr); }
                     else if (strncmp(ptr, "winc", 4) == 0)  { ptr += 4; while (*ptr == ' ') ptr++; winc = atoi(ptr); }
@@ -214,6 +274,8 @@ namespace UCI {
                     else if (strncmp(ptr, "movestogo", 9) == 0) { ptr += 9; while (*ptr == ' ') ptr++; movestogo = atoi(ptr); }
                     else if (strncmp(ptr, "depth", 5) == 0) { ptr += 5; while (*ptr == ' ') ptr++; depth = atoi(ptr); }
                     else if (strncmp(ptr, "movetime", 8) == 0) { ptr += 8; while (*ptr == ' ') ptr++; movetime = atoi(ptr); }
+                    else if (strncmp(ptr, "nodes", 5) == 0) { ptr += 5; while (*ptr == ' ') ptr++; nodes = atoll(ptr); }
+                    else if (strncmp(ptr, "mate", 4) == 0) { ptr += 4; while (*ptr == ' ') ptr++; mate = atoi(ptr); }
 
                     while (*ptr && *ptr != ' ') ptr++;
                     while (*ptr == ' ') ptr++;
@@ -221,10 +283,10 @@ namespace UCI {
 
                 Move best_move;
 
-                if (movetime > 0)
-                    best_move = game.searchWorker.searchPosition(game, game.config.search.maximumDepth, movetime);
-                else if (depth > 0)
-                    best_move = game.searchWorker.searchPosition(game, std::min(game.config.search.maximumDepth, depth), game.searchWorker.maximumSearchTime);
+                // Time budget from movetime or the clock, also caps node and mate searches
+                int think_time = game.searchWorker.maximumSearchTime;
+
+                if (movetime > 0) think_time = movetime;
                 else if (wtime > 0 && btime > 0)
                 {
                     int time_left = (game.turn == WHITE) ? wtime : btime;
@@ -232,18 +294,27 @@ namespace UCI {
                     if (movestogo <= 0) movestogo = 30;
 
                     int base_time = time_left / movestogo;
-                    int think_time = base_time + increment / 2;
+                    think_time = base_time + increment / 2;
 
                     int max_time = time_left * 60 / 100;
                     if (think_time > max_time) think_time = max_time;
                     if (think_time < 10) think_time = 10;
                     if (time_left < 60000) { think_time = time_left / 10; if (think_time < 5) think_time = 5; }
-
-                    best_move = game.searchWorker.searchPosition(game, 64, think_time);
                 }
+
+                if (mate > 0)
+                    best_move = game.searchWorker.searchMate(game, mate, think_time, (nodes > 0) ? nodes : 0);
+                else if (nodes > 0)
+                    best_move = game.searchWorker.searchPosition(game, (depth > 0) ? std::min(game.config.search.maximumDepth, depth) : game.config.search.maximumDepth, think_time, nodes, searchMoves);
+                else if (movetime > 0)
+                    best_move = game.searchWorker.searchPosition(game, game.config.search.maximumDepth, think_time, 0, searchMoves);
+                else if (depth > 0)
+                    best_move = game.searchWorker.searchPosition(game, std::min(game.config.search.maximumDepth, depth), game.searchWorker.maximumSearchTime, 0, searchMoves);
+                else if (wtime > 0 && btime > 0)
+                    best_move = game.searchWorker.searchPosition(game, 64, think_time, 0, searchMoves);
                 else
                 {
-                    best_move = game.searchWorker.searchPosition(game, std::min(game.config.search.initialDepth, game.config.search.maximumDepth), game.searchWorker.maximumSearchTime);
+                    best_move = game.searchWorker.searchPosition(game, std::min(game.config.search.initialDepth, game.config.search.maximumDepth), game.searchWorker.maximumSearchTime, 0, searchMoves);
                 }
 
                 std::cout << "bestmove " << ((best_move == 0) ? "(none)" : Board::moveToString(best_move)) << std::endl;
@@ -273,10 +344,12 @@ namespace UCI {
                 printf("  doQuiescense:           %d\n", game.config.search.doQuiescense);
                 printf("  doTranspositions:       %d\n", game.config.search.doTranspositions);
                 printf("  doBetaCutoffHistory:    %d\n", game.config.search.doBetaCutoffHistory);
+                printf("  doSeePruning:           %d\n", game.config.search.doSeePruning);
                 printf("  doInfo:                 %d\n", game.config.search.doInfo);
                 printf("  initialDepth:           %d\n", game.config.search.initialDepth);
                 printf("  maximumDepth:           %d\n", game.config.search.maximumDepth);
                 printf("  maximumQuiescenseDepth: %d\n", game.config.search.maximumQuiescenseDepth);
+                printf("  multiPV:                %d\n", game.config.search.multiPV);
 
                 printf("===========================\n");
                 fflush(stdout);